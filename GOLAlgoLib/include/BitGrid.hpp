@@ -0,0 +1,74 @@
+#ifndef BitGrid_hpp_
+#define BitGrid_hpp_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "Graphics2D.hpp"
+#include "HashQuadtree.hpp"
+#include "LifeRule.hpp"
+
+namespace gol {
+
+// A bounded universe stored densely, one bit per cell and 64 cells to a word.
+// A generation advances a whole word at a time by adding the eight neighbor
+// words with bit-sliced adders, so a bounded run costs a few operations per 64
+// cells rather than a quadtree rebuild per generation.
+class BitGrid {
+  public:
+    // Larger universes are left to HashLife so that the two generations of
+    // the grid stay within a few tens of megabytes.
+    constexpr static int64_t MaxCellCount = int64_t{1} << 28;
+
+    // Universes up to this many cells cost little enough per generation to
+    // always be stepped densely.
+    constexpr static int64_t SmallCellCount = int64_t{1} << 20;
+
+    // Larger universes are only stepped densely while at least one cell in
+    // this many is alive, since a sparse one is cheaper to advance in
+    // HashLife than to sweep in full every generation.
+    constexpr static int64_t CellsPerLiveCell = 256;
+
+    // Whether a universe of `size` can be stored. Both dimensions must be
+    // bounded.
+    static bool Fits(Size2 size);
+
+    // Whether a universe of `size` holding `population` live cells is
+    // cheaper to step on a grid than in HashLife.
+    static bool Prefers(Size2 size, const BigInt& population);
+
+    // Copies the cells of `tree` that lie within `size`. If `wrap` is true,
+    // the edges of the grid are joined as on a torus; otherwise everything
+    // outside of it is permanently dead.
+    BitGrid(const HashQuadtree& tree, Size2 size, bool wrap);
+
+    bool Get(Vec2 pos) const;
+
+    void Step(const LifeRule& rule);
+
+    HashQuadtree ToQuadtree() const;
+
+    Size2 Size() const { return m_Size; }
+
+  private:
+    // The word holding the cells of row y from x = 64 * word onwards, with
+    // the cell at x in bit x % 64.
+    uint64_t& Word(std::vector<uint64_t>& cells, int32_t y, size_t word) const;
+
+    void StepRow(int32_t y, const LifeRule& rule);
+
+  private:
+    Size2 m_Size;
+    bool m_Wrap;
+    size_t m_WordsPerRow;
+    // Clears the bits past the right edge in the last word of a row.
+    uint64_t m_LastWordMask;
+
+    std::vector<uint64_t> m_Cells;
+    std::vector<uint64_t> m_Next;
+};
+} // namespace gol
+
+#endif
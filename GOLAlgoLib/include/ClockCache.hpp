@@ -0,0 +1,112 @@
+#ifndef ClockCache_hpp_
+#define ClockCache_hpp_
+
+#include <ankerl/unordered_dense.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace gol {
+
+struct CacheStats {
+    uint64_t Hits = 0;
+    uint64_t Misses = 0;
+    uint64_t Evictions = 0;
+
+    constexpr CacheStats& operator+=(const CacheStats& other) {
+        Hits += other.Hits;
+        Misses += other.Misses;
+        Evictions += other.Evictions;
+        return *this;
+    }
+};
+
+// A map holding at most a fixed number of entries. Once full, inserting evicts
+// an entry using the CLOCK approximation of least-recently-used: a hand sweeps
+// over the entries, sparing (and clearing) any that were looked up since it
+// last passed, and replacing the first that was not.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ClockCache {
+  public:
+    explicit ClockCache(size_t capacity = 0) : m_Capacity(capacity) {}
+
+    std::optional<Value> Find(const Key& key) {
+        const auto it = m_Index.find(key);
+        if (it == m_Index.end()) {
+            ++m_Stats.Misses;
+            return std::nullopt;
+        }
+
+        ++m_Stats.Hits;
+        auto& slot = m_Slots[it->second];
+        slot.Referenced = true;
+        return slot.StoredValue;
+    }
+
+    void Insert(const Key& key, const Value& value) {
+        if (m_Capacity == 0) {
+            return;
+        }
+
+        if (const auto it = m_Index.find(key); it != m_Index.end()) {
+            m_Slots[it->second].StoredValue = value;
+            return;
+        }
+
+        if (m_Slots.size() < m_Capacity) {
+            m_Index.emplace(key, m_Slots.size());
+            m_Slots.push_back({key, value, false});
+            return;
+        }
+
+        while (m_Slots[m_Hand].Referenced) {
+            m_Slots[m_Hand].Referenced = false;
+            m_Hand = (m_Hand + 1) % m_Slots.size();
+        }
+
+        auto& victim = m_Slots[m_Hand];
+        m_Index.erase(victim.StoredKey);
+        m_Index.emplace(key, m_Hand);
+        victim = {key, value, false};
+        m_Hand = (m_Hand + 1) % m_Slots.size();
+        ++m_Stats.Evictions;
+    }
+
+    // Changes the number of entries kept. Shrinking discards every entry.
+    void SetCapacity(size_t capacity) {
+        if (capacity < m_Slots.size()) {
+            Clear();
+        }
+        m_Capacity = capacity;
+    }
+
+    void Clear() {
+        m_Slots.clear();
+        m_Index.clear();
+        m_Hand = 0;
+    }
+
+    size_t Capacity() const { return m_Capacity; }
+
+    size_t size() const { return m_Slots.size(); }
+
+    const CacheStats& Stats() const { return m_Stats; }
+
+  private:
+    struct Slot {
+        Key StoredKey;
+        Value StoredValue;
+        bool Referenced;
+    };
+
+    std::vector<Slot> m_Slots{};
+    ankerl::unordered_dense::map<Key, size_t, Hash> m_Index{};
+    size_t m_Capacity;
+    size_t m_Hand = 0;
+    CacheStats m_Stats{};
+};
+} // namespace gol
+
+#endif
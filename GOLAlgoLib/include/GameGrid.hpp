@@ -6,6 +6,7 @@
 #include <expected>
 #include <memory>
 #include <optional>
+#include <span>
 #include <stop_token>
 #include <vector>
 
@@ -78,7 +79,7 @@ class GameGrid {
     }
 
     const BigInt& Generation() const { return m_Generation; }
-    const BigInt& Population() const { return m_HashLifeData.Population(); }
+    BigInt Population() const { return m_HashLifeData.Population(); }
 
     // Indicates if the universe contains any live cells
     bool Dead() const;
@@ -86,6 +87,10 @@ class GameGrid {
     bool Set(int32_t x, int32_t y, bool active);
     bool Toggle(int32_t x, int32_t y);
 
+    // Sets every in-bounds cell of `positions` in a single pass over the
+    // tree.
+    void SetMany(std::span<const Vec2> positions, bool active);
+
     // Copies provided region to a new GameGrid.
     GameGrid SubRegion(Rect region) const;
 
@@ -117,9 +122,22 @@ class GameGrid {
     // Returns an unordered set of the universe's data.
     const HashQuadtree& Data() const;
 
+    // Checks `ruleString` against every rule notation a GameGrid can run.
+    static std::expected<void, std::string_view>
+    IsValidRule(std::string_view ruleString);
+
+    // Returns the universe size encoded in `ruleString`, which is empty for
+    // unbounded rules.
+    static std::expected<Size2, std::string_view>
+    ExtractDimensions(std::string_view ruleString);
+
     void SetRule(const LifeRule& rule);
     void SetRule(const LifeRule& rule, std::string_view ruleString);
 
+    // Applies a valid rule string, switching to the LargerThanLife algorithm
+    // for range-R rules and to HashLife for all others.
+    void SetRule(std::string_view ruleString);
+
     std::string_view GetRuleString() const;
 
     bool ShouldValidateCache() const;
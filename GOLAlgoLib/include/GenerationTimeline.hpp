@@ -0,0 +1,67 @@
+#ifndef GenerationTimeline_hpp_
+#define GenerationTimeline_hpp_
+
+#include <cstddef>
+#include <optional>
+#include <stop_token>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "GameGrid.hpp"
+
+namespace gol {
+
+// Checkpoints of a run, from which any earlier generation can be recomputed.
+// Each checkpoint is a GameGrid, which only holds the root of a canonical
+// tree, so a checkpoint costs little beyond the nodes that were new in its
+// generation. Holding it also keeps those nodes reachable for as long as the
+// timeline lives. Rewinding restarts from the nearest checkpoint, where the
+// cache already holds the results needed to advance again.
+class GenerationTimeline {
+  public:
+    constexpr static size_t DefaultCapacity = 256;
+
+    explicit GenerationTimeline(const BigInt& interval = BigOne,
+                                size_t capacity = DefaultCapacity);
+
+    // Sets the fewest generations between two checkpoints. Once the timeline
+    // is full, every other checkpoint is dropped and the spacing doubles, so
+    // that long runs stay covered end to end.
+    void SetInterval(const BigInt& interval);
+
+    // Records `grid` if it is at least the current spacing past the last
+    // checkpoint.
+    void Record(const GameGrid& grid);
+
+    // Records `grid` unconditionally, discarding the checkpoints at or after
+    // its generation. Used where the run may have diverged, such as after an
+    // edit.
+    void Branch(const GameGrid& grid);
+
+    void Clear();
+
+    // Returns the last checkpoint at or before `generation`, if any.
+    const GameGrid* Nearest(const BigInt& generation) const;
+
+    // Returns the universe at `generation`, advanced from the nearest
+    // checkpoint. Returns nothing if `generation` precedes the timeline or
+    // the advance was stopped.
+    std::optional<GameGrid> Rewind(const BigInt& generation,
+                                   std::stop_token stopToken = {}) const;
+
+    bool Empty() const { return m_Checkpoints.empty(); }
+    size_t Size() const { return m_Checkpoints.size(); }
+    const BigInt& Interval() const { return m_Interval; }
+
+  private:
+    void Thin();
+
+  private:
+    std::vector<GameGrid> m_Checkpoints;
+    BigInt m_MinInterval;
+    BigInt m_Interval;
+    size_t m_Capacity;
+};
+} // namespace gol
+
+#endif
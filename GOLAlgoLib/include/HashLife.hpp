@@ -1,8 +1,12 @@
 #ifndef HashLife_hpp_
 #define HashLife_hpp_
 
+#include <array>
 #include <concepts>
+#include <memory>
+#include <optional>
 
+#include "BitGrid.hpp"
 #include "HashQuadtree.hpp"
 #include "LifeAlgorithm.hpp"
 
@@ -30,6 +34,20 @@ class HashLife : public LifeAlgorithm {
     std::unique_ptr<LifeAlgorithm> Clone() const override;
 
   private:
+    // Makes this instance's rule the current thread's, since threads may
+    // step universes under different rules in turn.
+    void BindRule() const;
+
+    BigInt StepImpl(HashQuadtree& data, const BigInt& numSteps,
+                    std::stop_token stopToken);
+
+    // Advances a universe bounded in both dimensions on a BitGrid, since
+    // bounded topologies only allow single generations and rebuilding the
+    // tree for each one dominates. Only used when BitGrid::Prefers it, so
+    // large sparse universes stay in the tree.
+    BigInt StepBounded(HashQuadtree& data, Rect bounds, const BigInt& numSteps,
+                       std::stop_token stopToken);
+
     int32_t DoOneJump(HashQuadtree& data, int32_t advanceLevel,
                       std::stop_token stopToken);
 
@@ -61,12 +79,30 @@ class HashLife : public LifeAlgorithm {
   private:
     std::unique_ptr<Topology> m_Topology;
 
+    // Shared between clones, since the rule's table is large.
+    std::shared_ptr<const LifeRule> m_Rule;
+
+    // The dense copy of the last bounded universe stepped, along with the
+    // tree it was written back as, so that consecutive steps reuse it.
+    std::optional<BitGrid> m_BoundedGrid;
+    const LifeNode* m_BoundedRoot = FalseNode;
+    Vec2L m_BoundedSeedOffset{};
+
     static thread_local LifeRule s_Rule;
 
-    // The cache for the HashLife algorithm when the step size is bounded.
-    static thread_local ankerl::unordered_dense::map<SlowKey, const LifeNode*,
-                                                     SlowHash>
-        s_SlowCache;
+    // The rule tables applied on even and odd generations. These only differ
+    // for B0 rules; see LifeRule::PhaseTable.
+    static thread_local std::array<LifeRule::LookupTable, 2> s_PhaseTables;
+
+    // The parity of the generation currently being advanced from.
+    static thread_local int32_t s_Phase;
+
+    // The levels below a jump's root whose advances get their own trace
+    // zones. Deeper calls are too many and too short to show up.
+    constexpr static int32_t TracedLevels = 1;
+
+    // The level of the root advanced by the current jump.
+    static thread_local int32_t s_JumpDepth;
 };
 } // namespace gol
 
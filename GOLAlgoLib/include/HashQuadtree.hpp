@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <ankerl/unordered_dense.h>
 #include <array>
+#include <atomic>
 #include <bit>
 #include <bitset>
 #include <compare>
@@ -13,9 +14,11 @@
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <print>
 #include <ranges>
+#include <shared_mutex>
 #include <span>
 #include <stack>
 #include <stop_token>
@@ -24,6 +27,7 @@
 #include <vector>
 
 #include "BigInt.hpp"
+#include "ClockCache.hpp"
 #include "Graphics2D.hpp"
 #include "LifeDataStructure.hpp"
 #include "LifeHashSet.hpp"
@@ -48,21 +52,91 @@ struct SlowHash {
     size_t operator()(SlowKey key) const noexcept;
 };
 
+using SlowResultCache = ClockCache<SlowKey, const LifeNode*, SlowHash>;
+
+// The results of advancing nodes under a single rule. Nodes are shared
+// between rules, but what they advance to is not.
+struct RuleResultCache {
+    // The most fast results kept before they are discarded.
+    constexpr inline static auto MaxResultCount = 1UZ << 24UZ;
+
+    // Approximate memory used by one slow result: its slot plus its index
+    // entry and bucket.
+    constexpr inline static auto SlowEntryBytes =
+        2 * (sizeof(SlowKey) + sizeof(const LifeNode*)) + sizeof(size_t);
+
+    explicit RuleResultCache(size_t slowCapacity);
+
+    // Results of HashLife's unbounded advance, which moves a node of level L
+    // forward 2^(L - 2) generations.
+    ankerl::unordered_dense::map<const LifeNode*, const LifeNode*>
+        FastResults{};
+
+    // Results of HashLife's bounded advance, one cache for each generation
+    // parity (see LifeRule::PhaseTable). Step counts that are not powers of
+    // two produce many distinct keys, so these are size-capped.
+    std::array<SlowResultCache, 2> SlowResults{};
+
+    // When this rule was last selected, for evicting the stalest rule.
+    uint64_t LastUsed = 0;
+};
+
 // The cache used for the HashLife algorithm.
 struct HashLifeCache {
+    // The most rules whose results are kept at once.
+    constexpr inline static auto MaxRuleCount = 8UZ;
+
+    constexpr inline static auto DefaultSlowCacheBudget = 64UZ << 20UZ;
+
     // Bump-pointer arena where all LifeNodes are stored. Nodes are only
-    // accessed by pointer outside of the cache.
-    LifeNodeArena NodeStorage{};
+    // accessed by pointer outside of the cache, and every HashQuadtree holds
+    // the arena its nodes were made in, so that a reset cache's nodes are
+    // freed once the last tree using them is gone.
+    std::shared_ptr<LifeNodeArena> NodeStorage =
+        std::make_shared<LifeNodeArena>();
 
-    ankerl::unordered_dense::map<const LifeNode*, const LifeNode*, LifeNodeHash,
-                                 LifeNodeEqual>
-        NodeMap{};
+    // Canonicalizes nodes so that identical subtrees share one pointer.
+    ankerl::unordered_dense::set<const LifeNode*, LifeNodeHash, LifeNodeEqual>
+        NodeSet{};
 
     // Level-indexed cache for empty nodes. Index i holds the empty node for
     // size 2^i
     std::vector<const LifeNode*> EmptyNodeCache{};
 
-    HashLifeCache();
+    // Advance results keyed by LifeRule::Fingerprint, so that switching back
+    // to a previous rule reuses everything computed under it. Threads keep
+    // their current rule's results alive even after it is evicted.
+    ankerl::unordered_dense::map<uint64_t, std::shared_ptr<RuleResultCache>>
+        RuleResults{};
+    uint64_t RuleUseCount = 0;
+
+    // The number of slow results each rule keeps per generation parity.
+    size_t SlowCacheCapacity =
+        DefaultSlowCacheBudget / RuleResultCache::SlowEntryBytes;
+
+    // Set when several threads may use the cache at once, in which case every
+    // access to the members above holds Mutex.
+    bool Shared = false;
+    // Set while a cache that is not shared is lent to a second thread (see
+    // HashQuadtree::SetCacheConcurrent), which must then lock it too.
+    std::atomic<bool> Concurrent = false;
+    std::shared_mutex Mutex{};
+
+    bool NeedsLocking() const {
+        return Shared || Concurrent.load(std::memory_order_acquire);
+    }
+
+    // Returns the results for `fingerprint`, creating them if needed and
+    // evicting the least recently used rule when over budget.
+    std::shared_ptr<RuleResultCache> ResultsFor(uint64_t fingerprint);
+
+    // Bumped by Reset, so that other threads drop what they still hold of
+    // the cache's previous contents (see HashQuadtree::ActiveCache).
+    std::atomic<uint64_t> Generation = 0;
+
+    // Discards everything and starts a new NodeStorage. The old one lives on
+    // for as long as trees hold its nodes.
+    void Reset();
 };
 
 // This is the primary data structure for executing the HashLife algorithm. It
@@ -70,9 +144,8 @@ struct HashLifeCache {
 // many STL algorithms.
 class HashQuadtree : public LifeDataStructure {
   public:
-    // The maximum number of distinct caches that can be stored in static
-    // memory.
-    constexpr inline static auto MaxCacheCount = 200UZ;
+    // The deepest tree whose node positions fit in 64 bits.
+    constexpr inline static int32_t MaxNodeWalkDepth = 62;
 
     class Iterator {
       private:
@@ -124,8 +197,29 @@ class HashQuadtree : public LifeDataStructure {
     HashQuadtree();
     HashQuadtree(std::span<const Vec2> data, Vec2 offset = {});
 
+    // Selects the cache that nodes and results are stored in for the current
+    // thread. Threads that never select one share cache 0.
     static void SetCacheIndex(size_t index);
 
+    // Returns the index of a cache no one else is using. Caches are created
+    // on first use and reused once released, so there are only ever as many
+    // as have been in use at once.
+    static size_t AcquireCache();
+
+    // Returns the index of the cache shared by every caller, so that editors
+    // holding the same patterns store their nodes and results only once.
+    // Unlike other caches, it may be used by several threads at once.
+    static size_t AcquireSharedCache();
+
+    // Gives up a cache from AcquireCache or AcquireSharedCache. Once no one
+    // holds it, its contents are discarded and it returns to the pool. No
+    // thread may still be using it by then.
+    static void ReleaseCache(size_t index);
+
+    // Makes every access to a cache that is not shared lock it, for while a
+    // second thread borrows it. Unmark it only once that thread is done.
+    static void SetCacheConcurrent(size_t index, bool concurrent);
+
   public:
     bool empty() const;
 
@@ -136,7 +230,9 @@ class HashQuadtree : public LifeDataStructure {
     // interaction and display of a small subsection of the universe.
     Iterator begin(Rect bounds) const;
 
-    const BigInt& Population() const;
+    // Constant time unless the tree is large enough for its population to
+    // exceed 64 bits.
+    BigInt Population() const;
 
     // Applies func to all cells within the given bounds. More efficient than
     // iterators because recursion can be used.
@@ -147,16 +243,59 @@ class HashQuadtree : public LifeDataStructure {
     void ForEachCell(const Func& func, const BigRect& bounds,
                      int32_t minLevel) const;
 
+    // Applies func to every non-empty node of the given level that intersects
+    // the given bounds, along with the position of its upper-left corner.
+    // Walks down from the root without creating nodes, so trees deeper than
+    // MaxNodeWalkDepth are skipped.
+    template <std::invocable<const LifeNode*, Vec2L> Func>
+    void ForEachNode(const Func& func, Rect bounds, int32_t level) const;
+
+    // Marks every texel of `bounds` that holds a live cell in `buffer`, where
+    // texels are squares of 2^level cells counted from the upper-left corner
+    // of `bounds`. Texel (x, y) is bit x % 8 of byte y * stride + x / 8, with
+    // a stride of ceil(columns / 8) bytes. Level 0 writes whole 8x8 blocks as
+    // bitmasks and coarser levels mark each non-empty node of that level, so
+    // no callback runs per cell. Coarse texels follow the tree's nodes, so
+    // `bounds` should be aligned to them. Like ForEachNode, never creates
+    // nodes.
+    void RasterizeRegion(Rect bounds, int32_t level,
+                         std::span<uint8_t> buffer) const;
+
     // Returns the number of levels in the current tree.
     int32_t CalculateDepth() const;
     // Returns the length/width of the tree's root node.
     int64_t CalculateTreeSize() const;
+    // Returns the offset the tree was constructed with. Together with Data()
+    // and CalculateDepth(), this identifies the tree's contents.
+    Vec2L SeedOffset() const;
+
+    // The smallest node holding every live cell that the tree reaches by
+    // always descending into its only non-empty quadrant.
+    struct CoreNode {
+        const LifeNode* Node; // FalseNode when the tree is empty
+        int32_t Level;
+        Vec2L Position; // Upper-left corner
+    };
 
+    // Returns the tree's core, or nothing if the tree is deeper than
+    // MaxNodeWalkDepth. Nodes are canonical, so two trees in one cache whose
+    // cores share a node hold the same cells, shifted by the difference of
+    // their positions. Never creates nodes.
+    std::optional<CoreNode> Core() const;
+
+    // Compares live cells. Trees whose nodes line up are compared node by
+    // node, and so in time proportional to their depth when they are equal
+    // and share a cache.
     bool operator==(const HashQuadtree& ther) const;
     bool operator!=(const HashQuadtree& other) const;
 
     void Set(Vec2 pos, bool alive) override;
 
+    // Sets every cell in `positions` at once. Cells are grouped by the
+    // subtree they fall in, so each node on their paths is rebuilt once
+    // rather than once per cell.
+    void SetMany(std::span<const Vec2> positions, bool alive);
+
     // Inserts `other` shifted by `offset` into this tree.
     // This operation can merge aligned subtrees directly to avoid
     // per-cell insertion in common cases.
@@ -168,6 +307,23 @@ class HashQuadtree : public LifeDataStructure {
 
     HashQuadtree Extract(Rect region) const;
 
+    // Turns the universe a quarter turn about the origin, moving the cell at
+    // (x, y) to (-1 - y, x) when clockwise and to (y, -1 - x) otherwise.
+    // Each distinct node is transformed once, so the cost follows the number
+    // of distinct nodes rather than the population.
+    void Rotate90(bool clockwise = true);
+
+    // Mirrors the universe about the origin, moving the cell at (x, y) to
+    // (x, -1 - y) if `vertical` is true and to (-1 - x, y) otherwise. Costs
+    // the same as Rotate90.
+    void Flip(bool vertical);
+
+    // Swaps the coordinates of every cell. Costs the same as Rotate90.
+    void Transpose();
+
+    // Moves every cell by `offset` in constant time.
+    void Translate(Vec2L offset);
+
     Rect FindBoundingBox() const override;
 
     // This is the primary interface for interaction with HashLife's cache.
@@ -181,19 +337,73 @@ class HashQuadtree : public LifeDataStructure {
 
     void CacheResult(const LifeNode* key, const LifeNode* value) const;
 
-    static void ClearCache();
+    std::optional<const LifeNode*> FindSlow(SlowKey key, int32_t phase) const;
+
+    void CacheSlowResult(SlowKey key, int32_t phase,
+                         const LifeNode* value) const;
+
+    // Selects which rule's results Find and CacheResult operate on for the
+    // current thread.
+    static void SetRuleFingerprint(uint64_t fingerprint);
+
+    // Limits the memory each rule's slow results may use, in bytes. Shrinking
+    // the budget discards the results already stored. Does nothing and
+    // returns false while the shared cache has other users.
+    static bool SetSlowCacheBudget(size_t bytes);
+
+    // Hits, misses and evictions of the current rule's slow results.
+    static CacheStats SlowCacheStats();
+
+    // The number of nodes ever created in the current thread's cache.
+    static size_t CreatedNodeCount();
+
+    // Approximately how many bytes the current thread's cache holds, counting
+    // its nodes, their hash set and every rule's results.
+    static size_t CacheMemoryUsage();
+
+    // Forgets every node and result of the current thread's cache. Nodes stay
+    // allocated for the trees using them. Does nothing and returns false while
+    // another thread may be using the cache, since it would go on to create
+    // duplicates of the forgotten nodes.
+    static bool ClearCache();
+
+    // Copies the tree's nodes into the current thread's cache if they live in
+    // another one. Every change to the tree does this first, as must anything
+    // caching results keyed by its nodes, since another cache's nodes are
+    // freed along with it.
+    void AdoptNodes();
 
     void ExpandUniverse(int32_t targetLevel);
     const LifeNode* ExpandNode(const LifeNode* node, int32_t level) const;
 
     const LifeNode* Data() const;
+    // `root` must come from the current thread's cache, or from the tree's
+    // own arena.
     void OverwriteData(const LifeNode* root, int32_t level);
     void OverwriteData(const LifeNode* root, int32_t level, Vec2 offset);
 
   private:
+    // The upper-left corner of the root.
+    Vec2L RootPosition() const;
+
+    using ImportMemo =
+        ankerl::unordered_dense::map<const LifeNode*, const LifeNode*>;
+
+    // Whether `node` lives in an arena other than the one with id `arena`.
+    static bool IsForeign(const LifeNode* node, uint32_t arena);
+
+    // Returns the copy of `node` in the current thread's cache, creating its
+    // descendants there as needed.
+    const LifeNode* ImportNode(const LifeNode* node, ImportMemo& memo) const;
+
     const LifeNode* SetImpl(const LifeNode* node, Vec2L pos, Vec2 targetPos,
                             int32_t level, bool alive);
 
+    // Partitions `cells`, which all lie within `node`, among its quadrants.
+    const LifeNode* SetManyImpl(const LifeNode* node, Vec2L pos,
+                                std::span<Vec2L> cells, int32_t level,
+                                bool alive) const;
+
     bool GetImpl(const LifeNode* node, Vec2L pos, Vec2 targetPos,
                  int32_t level) const;
 
@@ -207,6 +417,28 @@ class HashQuadtree : public LifeDataStructure {
     void ForEachImpl(const Func& func, const LifeNode* node, Vec2L pos,
                      int32_t level, int32_t minLevel, Rect bounds) const;
 
+    template <std::invocable<const LifeNode*, Vec2L> Func>
+    void ForEachNodeImpl(const Func& func, const LifeNode* node, Vec2L pos,
+                         int32_t level, int32_t targetLevel,
+                         Rect bounds) const;
+
+    struct RasterTarget {
+        std::span<uint8_t> Buffer;
+        int64_t Width;
+        int64_t Height;
+        int32_t Level;
+        size_t Stride;
+    };
+
+    // `pos` is relative to the upper-left corner of the rasterized region.
+    static void RasterizeRegionImpl(const RasterTarget& target,
+                                    const LifeNode* node, Vec2L pos,
+                                    int32_t level);
+
+    // Returns the cells of a level-3 node as 8 rows of 8 bits, with the cell
+    // at (x, y) in bit 8 * y + x.
+    static uint64_t BlockMask(const LifeNode* node, int32_t level = 3);
+
     template <std::invocable<const BigVec2&> Func>
     void ForEachBigImpl(const Func& func, const LifeNode* node, int32_t level,
                         int32_t minLevel, const BigInt& left, const BigInt& top,
@@ -230,6 +462,26 @@ class HashQuadtree : public LifeDataStructure {
 
     enum class Quadrant { NW, NE, SW, SE };
 
+    // Symmetries of a square that map each node onto itself.
+    enum class NodeTransform {
+        RotateClockwise,
+        RotateCounterclockwise,
+        FlipHorizontal,
+        FlipVertical,
+        Transpose
+    };
+
+    using TransformMemo =
+        ankerl::unordered_dense::map<const LifeNode*, const LifeNode*>;
+
+    // Applies `transform` to the root in place, then moves the root so that
+    // the universe is transformed about the origin.
+    void ApplyTransform(NodeTransform transform);
+
+    const LifeNode* TransformNode(const LifeNode* node, int32_t level,
+                                  NodeTransform transform,
+                                  TransformMemo& memo) const;
+
     CenteredNodeResult GetCenteredNode(int32_t level) const;
 
     const LifeNode* ReplaceAlongPath(const LifeNode* node, int32_t level,
@@ -250,14 +502,44 @@ class HashQuadtree : public LifeDataStructure {
                                    int32_t srcLevel, Vec2L srcPos) const;
 
   private:
-    static std::array<HashLifeCache, MaxCacheCount> s_Cache;
-
+    // Indexed by cache index. Entries are created by the first thread to use
+    // them, and are never destroyed, so that s_ActiveCache stays valid.
+    static std::mutex s_CacheMutex;
+    static std::vector<std::unique_ptr<HashLifeCache>> s_Caches;
+    static std::vector<size_t> s_FreeCaches;
+    // The index of the shared cache, or 0 while no one holds it.
+    static size_t s_SharedCache;
+    static size_t s_SharedCacheUsers;
+
+    // Pops the free list or adds a cache index. s_CacheMutex must be held.
+    static size_t NextFreeCache();
+    // Whether `cache` has a single holder, so that changing it affects no one
+    // else. s_CacheMutex must be held.
+    static bool IsSoleUser(const HashLifeCache& cache);
+
+    // Populations of nodes whose counts overflow LifeNode::Population.
     static thread_local ankerl::unordered_dense::map<
         const LifeNode*, BigInt, LifeNodeHash, LifeNodeEqual>
         s_PopulationCache;
+    // Cleared when LifeNodeArena::DestroyedCount changes from this.
+    static thread_local uint64_t s_PopulationArenas;
     static thread_local size_t s_CacheIndex;
+    // Resolved lazily from s_CacheIndex.
+    static thread_local HashLifeCache* s_ActiveCache;
+    // The Generation of s_ActiveCache that s_ActiveResults belongs to.
+    static thread_local uint64_t s_ActiveGeneration;
+
+    static HashLifeCache& ActiveCache();
+
+    static thread_local uint64_t s_RuleFingerprint;
+    // Resolved lazily from s_CacheIndex and s_RuleFingerprint.
+    static thread_local std::shared_ptr<RuleResultCache> s_ActiveResults;
+
+    static RuleResultCache& ActiveResults();
 
     const LifeNode* m_Root = FalseNode;
+    // The arena holding the root, which holds every node below it too.
+    std::shared_ptr<const LifeNodeArena> m_Arena;
 
     // The offset when this tree was constructed, before applying expansions
     Vec2L m_SeedOffset;
@@ -265,6 +547,24 @@ class HashQuadtree : public LifeDataStructure {
     int32_t m_Depth = 0;
 };
 
+// Holds a cache from HashQuadtree::AcquireCache, or the shared cache, for as
+// long as it lives.
+class HashLifeCacheLease {
+  public:
+    explicit HashLifeCacheLease(bool shared = false)
+        : m_Index(shared ? HashQuadtree::AcquireSharedCache()
+                         : HashQuadtree::AcquireCache()) {}
+    ~HashLifeCacheLease() { HashQuadtree::ReleaseCache(m_Index); }
+
+    HashLifeCacheLease(const HashLifeCacheLease&) = delete;
+    auto& operator=(const HashLifeCacheLease&) = delete;
+
+    size_t Index() const { return m_Index; }
+
+  private:
+    size_t m_Index;
+};
+
 template <int32_t Size>
 constexpr int32_t Index2D(int32_t x, int32_t y) {
     return y * Size + x;
@@ -379,6 +679,48 @@ void HashQuadtree::ForEachCell(const Func& func, Rect bounds,
     return ForEachImpl(func, node, offset, std::min(m_Depth, 32), minLevel,
                        bounds);
 }
+
+template <std::invocable<const LifeNode*, Vec2L> Func>
+void HashQuadtree::ForEachNodeImpl(const Func& func, const LifeNode* node,
+                                   Vec2L pos, int32_t level,
+                                   int32_t targetLevel, Rect bounds) const {
+    if (node == FalseNode || node->IsEmpty ||
+        !IntersectsBounds(bounds, pos, level)) {
+        return;
+    }
+
+    if (level == targetLevel) {
+        func(node, pos);
+        return;
+    }
+
+    const auto childLevel = level - 1;
+    const auto halfSize = Pow2(childLevel);
+
+    ForEachNodeImpl(func, node->NorthWest, pos, childLevel, targetLevel,
+                    bounds);
+    ForEachNodeImpl(func, node->NorthEast, {pos.X + halfSize, pos.Y},
+                    childLevel, targetLevel, bounds);
+    ForEachNodeImpl(func, node->SouthWest, {pos.X, pos.Y + halfSize},
+                    childLevel, targetLevel, bounds);
+    ForEachNodeImpl(func, node->SouthEast,
+                    {pos.X + halfSize, pos.Y + halfSize}, childLevel,
+                    targetLevel, bounds);
+}
+
+template <std::invocable<const LifeNode*, Vec2L> Func>
+void HashQuadtree::ForEachNode(const Func& func, Rect bounds,
+                               int32_t level) const {
+    if (m_Root == FalseNode || level < 0 || level > m_Depth ||
+        m_Depth > MaxNodeWalkDepth) {
+        return;
+    }
+
+    const auto half = (m_Depth == 0 ? 0 : Pow2(m_Depth - 1));
+    return ForEachNodeImpl(func, m_Root,
+                           {m_SeedOffset.X - half, m_SeedOffset.Y - half},
+                           m_Depth, level, bounds);
+}
 } // namespace gol
 
 #endif
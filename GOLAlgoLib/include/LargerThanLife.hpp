@@ -0,0 +1,57 @@
+#ifndef LargerThanLife_hpp_
+#define LargerThanLife_hpp_
+
+#include <memory>
+
+#include "HashQuadtree.hpp"
+#include "LargerThanLifeRule.hpp"
+#include "LifeAlgorithm.hpp"
+
+namespace gol {
+
+// A dense engine for range-R rules. Each generation rasterizes the tiles
+// around live cells into summed-area tables, so counting a neighborhood costs
+// the same four lookups regardless of the rule's range, and empty space
+// between distant patterns costs nothing.
+class LargerThanLife : public LifeAlgorithm {
+  public:
+    static std::string_view Identifier;
+
+    LargerThanLife(const LargerThanLifeRule& rule);
+
+    LargerThanLife(const LargerThanLifeRule& rule,
+                   std::unique_ptr<Topology> topology);
+
+    void SetTopology(std::unique_ptr<Topology> topology) override;
+
+    // Larger than Life rules cannot be expressed as a LifeRule, so this only
+    // exists to satisfy LifeAlgorithm and asserts if called. Callers must
+    // swap in HashLife instead, as GameGrid::SetRule does.
+    void SetRule(const LifeRule& rule) override;
+
+    void SetRule(const LargerThanLifeRule& rule);
+
+    bool CompatibleWith(const LifeDataStructure& data) const override;
+
+    // Larger than Life has no equivalent of hyper speed, so asking for zero
+    // generations advances by one.
+    BigInt Step(LifeDataStructure& data, const BigInt& numSteps,
+                std::stop_token stopToken = {}) override;
+
+    std::string_view GetIdentifier() const override;
+
+    std::unique_ptr<LifeAlgorithm> Clone() const override;
+
+  private:
+    // The smallest width of a tile, in cells. Tiles are widened to the range.
+    constexpr static int32_t MinTileSize = 64;
+
+    void AdvanceGeneration(HashQuadtree& data) const;
+
+  private:
+    LargerThanLifeRule m_Rule;
+    std::unique_ptr<Topology> m_Topology;
+};
+} // namespace gol
+
+#endif
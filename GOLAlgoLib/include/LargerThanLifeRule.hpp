@@ -0,0 +1,249 @@
+#ifndef LargerThanLifeRule_hpp_
+#define LargerThanLifeRule_hpp_
+
+#include <charconv>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string_view>
+
+#include "Graphics2D.hpp"
+
+namespace gol {
+
+using namespace std::literals::string_view_literals;
+
+// A range-R outer-totalistic rule over a square (Moore) neighborhood, written
+// in Golly's "Larger than Life" notation, e.g. "R5,C0,M1,S34..58,B34..45,NM".
+// An optional ":Pw,h" suffix bounds the universe to a plane.
+class LargerThanLifeRule {
+  public:
+    constexpr static int32_t MaxRange = 500;
+
+    constexpr static std::expected<LargerThanLifeRule, std::string_view>
+    Make(std::string_view ruleString);
+
+    constexpr static std::expected<void, std::string_view>
+    IsValidRule(std::string_view ruleString);
+
+    // Whether `ruleString` is written in Larger than Life notation, regardless
+    // of whether it is valid.
+    constexpr static bool IsLargerThanLifeRule(std::string_view ruleString);
+
+    // The number of cells in each direction that make up a neighborhood.
+    constexpr int32_t Range() const { return m_Range; }
+
+    // Whether a cell counts itself as one of its neighbors.
+    constexpr bool CountsMiddle() const { return m_CountsMiddle; }
+
+    constexpr bool Survives(int32_t count) const {
+        return count >= m_SurviveMin && count <= m_SurviveMax;
+    }
+
+    constexpr bool IsBorn(int32_t count) const {
+        return count >= m_BirthMin && count <= m_BirthMax;
+    }
+
+    constexpr std::optional<Rect> Bounds() const;
+
+  private:
+    constexpr LargerThanLifeRule() = default;
+
+    constexpr static std::optional<int32_t> ParseInt(std::string_view text);
+
+    struct CountRange {
+        int32_t Min;
+        int32_t Max;
+    };
+    constexpr static std::optional<CountRange>
+    ParseRange(std::string_view text);
+
+  private:
+    int32_t m_Range = 1;
+    bool m_CountsMiddle = false;
+    int32_t m_SurviveMin = 0;
+    int32_t m_SurviveMax = 0;
+    int32_t m_BirthMin = 0;
+    int32_t m_BirthMax = 0;
+    Rect m_Bounds{};
+};
+
+constexpr std::optional<int32_t>
+LargerThanLifeRule::ParseInt(std::string_view text) {
+    auto value = 0;
+    const auto [pointer, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || pointer != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+constexpr std::optional<LargerThanLifeRule::CountRange>
+LargerThanLifeRule::ParseRange(std::string_view text) {
+    const auto separator = text.find("..");
+    if (separator == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    const auto min = ParseInt(text.substr(0, separator));
+    const auto max = ParseInt(text.substr(separator + 2));
+    if (!min || !max || *min > *max) {
+        return std::nullopt;
+    }
+    return CountRange{*min, *max};
+}
+
+constexpr bool
+LargerThanLifeRule::IsLargerThanLifeRule(std::string_view ruleString) {
+    return !ruleString.empty() &&
+           (ruleString[0] == 'R' || ruleString[0] == 'r');
+}
+
+constexpr std::expected<LargerThanLifeRule, std::string_view>
+LargerThanLifeRule::Make(std::string_view ruleString) {
+    if (!IsLargerThanLifeRule(ruleString)) {
+        return std::unexpected{
+            "Rule string must be in R...,C...,M...,S...,B... format."sv};
+    }
+
+    const auto suffixBegin = ruleString.find(':');
+    auto remaining = ruleString.substr(0, suffixBegin);
+    const auto nextToken = [&] {
+        const auto comma = remaining.find(',');
+        const auto token = remaining.substr(0, comma);
+        remaining = comma == std::string_view::npos ? std::string_view{}
+                                                    : remaining.substr(comma + 1);
+        return token;
+    };
+    // `prefixes` holds the upper and lower case forms of the expected prefix.
+    const auto hasPrefix = [](std::string_view token,
+                              std::string_view prefixes) {
+        return !token.empty() && prefixes.contains(token[0]);
+    };
+
+    LargerThanLifeRule rule{};
+
+    const auto rangeToken = nextToken();
+    const auto range = ParseInt(rangeToken.substr(1));
+    if (!range || *range < 1 || *range > MaxRange) {
+        return std::unexpected{"Range must be between 1 and 500."sv};
+    }
+    rule.m_Range = *range;
+
+    const auto statesToken = nextToken();
+    if (!hasPrefix(statesToken, "Cc"sv)) {
+        return std::unexpected{"Expected a state count after the range."sv};
+    }
+    // Golly writes two-state rules as C0 as well as C2.
+    const auto states = ParseInt(statesToken.substr(1));
+    if (!states || (*states != 0 && *states < 2)) {
+        return std::unexpected{"State count must be at least 2."sv};
+    }
+    if (*states > 2) {
+        return std::unexpected{
+            "Larger than Life rules with more than two states are not "
+            "currently supported."sv};
+    }
+
+    const auto middleToken = nextToken();
+    if (!hasPrefix(middleToken, "Mm"sv)) {
+        return std::unexpected{"Expected a middle cell flag after the state "
+                               "count."sv};
+    }
+    const auto middle = ParseInt(middleToken.substr(1));
+    if (!middle || (*middle != 0 && *middle != 1)) {
+        return std::unexpected{"Middle cell flag must be 0 or 1."sv};
+    }
+    rule.m_CountsMiddle = *middle == 1;
+
+    const auto maxCount = (2 * rule.m_Range + 1) * (2 * rule.m_Range + 1);
+
+    const auto surviveToken = nextToken();
+    if (!hasPrefix(surviveToken, "Ss"sv)) {
+        return std::unexpected{"Expected a survival range."sv};
+    }
+    const auto survive = ParseRange(surviveToken.substr(1));
+    if (!survive || survive->Max > maxCount) {
+        return std::unexpected{"Invalid survive neighbor range."sv};
+    }
+    rule.m_SurviveMin = survive->Min;
+    rule.m_SurviveMax = survive->Max;
+
+    const auto birthToken = nextToken();
+    if (!hasPrefix(birthToken, "Bb"sv)) {
+        return std::unexpected{"Expected a birth range."sv};
+    }
+    const auto birth = ParseRange(birthToken.substr(1));
+    if (!birth || birth->Max > maxCount) {
+        return std::unexpected{"Invalid birth neighbor range."sv};
+    }
+    if (birth->Min == 0) {
+        return std::unexpected{
+            "Larger than Life rules with birth on zero neighbors are not "
+            "currently supported."sv};
+    }
+    rule.m_BirthMin = birth->Min;
+    rule.m_BirthMax = birth->Max;
+
+    if (const auto neighborhoodToken = nextToken();
+        !neighborhoodToken.empty()) {
+        if (!hasPrefix(neighborhoodToken, "Nn"sv) ||
+            neighborhoodToken.size() != 2) {
+            return std::unexpected{"Invalid neighborhood."sv};
+        }
+        if (neighborhoodToken[1] != 'M' && neighborhoodToken[1] != 'm') {
+            return std::unexpected{"Only the Moore (NM) neighborhood is "
+                                   "currently supported."sv};
+        }
+    }
+    if (!remaining.empty()) {
+        return std::unexpected{"Unexpected text after the rule."sv};
+    }
+
+    if (suffixBegin == std::string_view::npos) {
+        return rule;
+    }
+
+    const auto topology = ruleString.substr(suffixBegin + 1);
+    if (topology.empty()) {
+        return std::unexpected{"Invalid topology specification."sv};
+    }
+    if (topology[0] != 'P' && topology[0] != 'p') {
+        return std::unexpected{"Larger than Life rules currently only support "
+                               "plane topologies."sv};
+    }
+
+    const auto separator = topology.find(',');
+    const auto width = ParseInt(topology.substr(1, separator - 1));
+    if (!width || *width < 0) {
+        return std::unexpected{"Invalid topology width."sv};
+    }
+    const auto height = separator == std::string_view::npos
+                            ? width
+                            : ParseInt(topology.substr(separator + 1));
+    if (!height || *height < 0) {
+        return std::unexpected{"Invalid topology height."sv};
+    }
+
+    rule.m_Bounds = Rect{0, 0, *width, *height};
+    return rule;
+}
+
+constexpr std::expected<void, std::string_view>
+LargerThanLifeRule::IsValidRule(std::string_view ruleString) {
+    if (const auto rule = Make(ruleString); !rule) {
+        return std::unexpected{rule.error()};
+    }
+    return {};
+}
+
+constexpr std::optional<Rect> LargerThanLifeRule::Bounds() const {
+    if (m_Bounds == Rect{}) {
+        return std::nullopt;
+    }
+    return m_Bounds;
+}
+
+} // namespace gol
+#endif
@@ -2,6 +2,8 @@
 #define LifeNode_hpp_
 
 #include <cstdint>
+#include <initializer_list>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -20,7 +22,14 @@ struct LifeNode {
     const LifeNode* SouthEast;
 
     uint64_t Hash{}; // Pre-computed hash
+
+    // The number of live cells in this node, or PopulationOverflow if that
+    // does not fit in 64 bits. Any node up to level 31 fits.
+    uint64_t Population{};
     bool IsEmpty = false;
+    // The LifeNodeArena::Id of the arena holding the node, or 0 for TrueNode.
+    // Fits in what would otherwise be padding.
+    uint32_t Arena = 0;
 
     constexpr LifeNode(const LifeNode* nw, const LifeNode* ne,
                        const LifeNode* sw, const LifeNode* se);
@@ -33,6 +42,9 @@ struct LifeNode {
 
 constexpr inline const LifeNode* FalseNode = nullptr;
 
+constexpr inline uint64_t PopulationOverflow =
+    std::numeric_limits<uint64_t>::max();
+
 // The result of advancing a node. Tells us how many generations it advanced
 // and returns the new node.
 struct NodeUpdateInfo {
@@ -40,9 +52,9 @@ struct NodeUpdateInfo {
     int32_t AdvanceLevel;
 };
 
-// Lightweight key for heterogeneous lookup into NodeMap.
-// Avoids constructing a full LifeNode (which computes Population) on every
-// lookup.
+// Lightweight key for heterogeneous lookup into NodeSet.
+// Avoids constructing a full LifeNode (which computes its hash, emptiness and
+// population) on every lookup.
 struct LifeNodeKey {
     const LifeNode* NorthWest;
     const LifeNode* NorthEast;
@@ -97,12 +109,33 @@ struct LifeNodeHash {
 // cleared.
 class LifeNodeArena {
   public:
+    LifeNodeArena();
+    ~LifeNodeArena();
+
+    LifeNodeArena(const LifeNodeArena&) = delete;
+    auto& operator=(const LifeNodeArena&) = delete;
+
+    // Identifies the arena's nodes (see LifeNode::Arena). Never 0.
+    uint32_t Id() const { return m_Id; }
+
+    // The number of arenas destroyed so far. Once it changes, the addresses
+    // of their nodes may be reused, so anything keyed by node pointer that
+    // outlives a cache must be discarded.
+    static uint64_t DestroyedCount();
+
     template <typename... Args>
     LifeNode* emplace(Args&&... args);
 
     // Returns the most recently emplaced node.
     LifeNode* last() const;
 
+    // The number of nodes emplaced since the last clear.
+    size_t size() const;
+
+    // The bytes allocated for nodes, including unused space in the newest
+    // block.
+    size_t AllocatedBytes() const;
+
     void clear();
 
   private:
@@ -113,16 +146,30 @@ class LifeNodeArena {
     };
     std::vector<std::unique_ptr<LifeNode, BlockDeleter>> m_Blocks;
     size_t m_Current = BlockCapacity; // Force first allocation
+
+    uint32_t m_Id;
 };
 
 constexpr LifeNode::LifeNode(const LifeNode* nw, const LifeNode* ne,
                              const LifeNode* sw, const LifeNode* se)
     : NorthWest(nw), NorthEast(ne), SouthWest(sw), SouthEast(se) {
     if consteval {
+        // The only node built at compile time is TrueNode, a single cell.
+        Population = 1;
     } else {
         IsEmpty = (nw ? nw->IsEmpty : true) && (ne ? ne->IsEmpty : true) &&
                   (sw ? sw->IsEmpty : true) && (se ? se->IsEmpty : true);
         Hash = ComputeHash(NorthWest, NorthEast, SouthWest, SouthEast);
+
+        for (const auto* child : {nw, ne, sw, se}) {
+            const auto count = child ? child->Population : 0;
+            if (count == PopulationOverflow ||
+                Population > PopulationOverflow - count) {
+                Population = PopulationOverflow;
+                break;
+            }
+            Population += count;
+        }
     }
 }
 
@@ -141,6 +188,7 @@ LifeNode* LifeNodeArena::emplace(Args&&... args) {
     }
     auto* node = m_Blocks.back().get() + m_Current++;
     std::construct_at(node, std::forward<Args>(args)...);
+    node->Arena = m_Id;
     return node;
 }
 
@@ -2,6 +2,7 @@
 #define LifeRule_hpp_
 #include <array>
 #include <charconv>
+#include <cstdint>
 #include <expected>
 #include <string_view>
 
@@ -34,14 +35,51 @@ class LifeRule {
                        TopologyKind topology = TopologyKind::Plane);
     constexpr const LookupTable& Table() const;
 
+    // Whether dead cells with no live neighbors are born. Such rules turn the
+    // empty background on every other generation, so they are simulated as
+    // two alternating rules on a complemented universe (see PhaseTable).
+    constexpr bool HasBirthOnZero() const;
+
+    // Whether the universe is stored complemented on every generation. B0
+    // rules with S8 keep the background on for good once it is born, so
+    // their patterns are the dead cells on a live background.
+    constexpr bool IsComplemented() const;
+
+    // The table to apply on even (0) or odd (1) generations. For B0 rules,
+    // even generations write the complement of the next state and odd
+    // generations read a complemented state, so the background stays empty
+    // and every even generation matches the real universe. Complemented
+    // rules read and write complemented states on both phases, and other
+    // rules use Table() for both phases.
+    constexpr LookupTable PhaseTable(int32_t phase) const;
+
+    // Identifies the rule table, so that two rules share a fingerprint exactly
+    // when they advance every pattern the same way. Bounds are not included.
+    constexpr uint64_t Fingerprint() const;
+
     constexpr std::optional<Rect> Bounds() const;
 
     constexpr TopologyKind GetTopology() const;
 
+    // Bit n is set when a dead cell with n live neighbors is born.
+    constexpr int32_t BirthMask() const;
+
+    // Bit n is set when a live cell with n live neighbors survives.
+    constexpr int32_t SurviveMask() const;
+
+    // The masks of the rule as it acts on the stored universe. These are the
+    // complementary rule's masks for complemented rules.
+    constexpr int32_t StoredBirthMask() const;
+    constexpr int32_t StoredSurviveMask() const;
+
   private:
     constexpr LookupTable BuildRuleTable(int32_t birthMask,
                                          int32_t surviveMask);
 
+    // Bit n is set when bit 8 - n of `mask` is clear. A complemented cell
+    // with n live neighbors is a real cell with 8 - n.
+    constexpr static int32_t ComplementMask(int32_t mask);
+
     template <typename ExtractType>
     constexpr static std::expected<ExtractType, std::string_view>
     TryMake(std::string_view ruleString);
@@ -50,6 +88,10 @@ class LifeRule {
     LookupTable m_RuleTable;
     Rect m_Bounds;
     TopologyKind m_TopologyKind;
+    int32_t m_BirthMask;
+    int32_t m_SurviveMask;
+    bool m_BirthOnZero;
+    uint64_t m_Fingerprint;
 };
 
 template <typename ExtractType>
@@ -74,9 +116,6 @@ LifeRule::TryMake(std::string_view ruleString) {
 
     auto birthMask = 0;
     for (char c : ruleString.substr(1, slash - 1)) {
-        if (c == '0') {
-            return std::unexpected{"B0 rules are not currently supported."sv};
-        }
         if (c < '0' || c > '8') {
             return std::unexpected{"Invalid birth neighbor count."sv};
         }
@@ -91,6 +130,8 @@ LifeRule::TryMake(std::string_view ruleString) {
         surviveMask |= (1 << (c - '0'));
     }
 
+    const bool birthOnZero = (birthMask & 1) != 0;
+
     const auto topologyKind =
         [&] -> std::expected<TopologyKind, std::string_view> {
         if (surviveEnd == ruleString.size()) {
@@ -170,6 +211,14 @@ LifeRule::TryMake(std::string_view ruleString) {
         return std::unexpected{bounds.error()};
     }
 
+    // Cells outside a bounded plane are permanently dead, which cannot be
+    // represented on the complemented generations of a B0 rule.
+    if (birthOnZero && *topologyKind == TopologyKind::Plane &&
+        *bounds != Size2{}) {
+        return std::unexpected{
+            "B0 rules are not currently supported on bounded planes."sv};
+    }
+
     if constexpr (std::is_same_v<ExtractType, LifeRule>) {
         return LifeRule{birthMask, surviveMask, Rect{Vec2{}, *bounds},
                         *topologyKind};
@@ -245,6 +294,37 @@ constexpr const LifeRule::LookupTable& LifeRule::Table() const {
     return m_RuleTable;
 }
 
+constexpr bool LifeRule::HasBirthOnZero() const { return m_BirthOnZero; }
+
+constexpr bool LifeRule::IsComplemented() const {
+    return m_BirthOnZero && (m_SurviveMask & (1 << 8)) != 0;
+}
+
+constexpr LifeRule::LookupTable LifeRule::PhaseTable(int32_t phase) const {
+    if (!m_BirthOnZero) {
+        return m_RuleTable;
+    }
+
+    // Only the center 2x2 of each result is meaningful.
+    constexpr uint16_t resultMask = 0x0033;
+
+    LookupTable table{};
+    for (uint32_t pattern = 0; pattern < NumLeafPatterns; ++pattern) {
+        if (IsComplemented()) {
+            table[pattern] = static_cast<uint16_t>(
+                m_RuleTable[~pattern & (NumLeafPatterns - 1)] ^ resultMask);
+        } else if (phase % 2 == 0) {
+            table[pattern] =
+                static_cast<uint16_t>(m_RuleTable[pattern] ^ resultMask);
+        } else {
+            table[pattern] = m_RuleTable[~pattern & (NumLeafPatterns - 1)];
+        }
+    }
+    return table;
+}
+
+constexpr uint64_t LifeRule::Fingerprint() const { return m_Fingerprint; }
+
 constexpr std::optional<Rect> LifeRule::Bounds() const {
     if (m_Bounds == Rect{}) {
         return std::nullopt;
@@ -254,10 +334,35 @@ constexpr std::optional<Rect> LifeRule::Bounds() const {
 
 constexpr TopologyKind LifeRule::GetTopology() const { return m_TopologyKind; }
 
+constexpr int32_t LifeRule::BirthMask() const { return m_BirthMask; }
+
+constexpr int32_t LifeRule::SurviveMask() const { return m_SurviveMask; }
+
+constexpr int32_t LifeRule::StoredBirthMask() const {
+    return IsComplemented() ? ComplementMask(m_SurviveMask) : m_BirthMask;
+}
+
+constexpr int32_t LifeRule::StoredSurviveMask() const {
+    return IsComplemented() ? ComplementMask(m_BirthMask) : m_SurviveMask;
+}
+
+constexpr int32_t LifeRule::ComplementMask(int32_t mask) {
+    auto result = 0;
+    for (auto count = 0; count <= 8; ++count) {
+        if (((mask >> (8 - count)) & 1) == 0) {
+            result |= 1 << count;
+        }
+    }
+    return result;
+}
+
 constexpr LifeRule::LifeRule(int32_t birthMask, int32_t surviveMask,
                              Rect bounds, TopologyKind topology)
     : m_RuleTable(BuildRuleTable(birthMask, surviveMask)), m_Bounds(bounds),
-      m_TopologyKind(topology) {}
+      m_TopologyKind(topology), m_BirthMask(birthMask),
+      m_SurviveMask(surviveMask), m_BirthOnZero((birthMask & 1) != 0),
+      m_Fingerprint((static_cast<uint64_t>(birthMask) << 32U) |
+                    static_cast<uint32_t>(surviveMask)) {}
 
 } // namespace gol
 #endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef PeriodDetector_hpp_
+#define PeriodDetector_hpp_
+
+#include <ankerl/unordered_dense.h>
+#include <cstddef>
+#include <optional>
+
+#include "BigInt.hpp"
+#include "GameGrid.hpp"
+#include "Graphics2D.hpp"
+#include "HashQuadtree.hpp"
+#include "LifeNode.hpp"
+
+namespace gol {
+// A cycle found by PeriodDetector. A still life has a period of one and no
+// displacement, an oscillator has no displacement, and a spaceship moves by
+// Displacement every period. A universe that dies out is a still life.
+struct PeriodInfo {
+    BigInt Start;  // The generation the cycle was first seen at
+    BigInt Period; // Generations between two matching observations
+    Vec2L Displacement;
+};
+
+// Watches a run for the universe repeating itself, up to translation. Each
+// observation is keyed by the tree's core node (see HashQuadtree::Core),
+// which is canonical, so finding a repeat takes time proportional to the
+// tree's depth rather than its population.
+//
+// Cycles are only found when they line up with what was observed: stepping
+// several generations at a time reports a multiple of the true period. A
+// spaceship must also return to the same alignment with the tree's squares,
+// which may take a few of its periods. Observations must all come from one
+// cache and one rule.
+class PeriodDetector {
+  public:
+    // Records `tree` as the universe at `generation`, returning the cycle it
+    // closes if it matches an earlier observation. Trees deeper than
+    // HashQuadtree::MaxNodeWalkDepth are not recorded.
+    std::optional<PeriodInfo> Observe(const HashQuadtree& tree,
+                                      const BigInt& generation);
+    std::optional<PeriodInfo> Observe(const GameGrid& grid) {
+        return Observe(grid.Data(), grid.Generation());
+    }
+
+    void Clear();
+
+    size_t Size() const { return m_Observations.size(); }
+
+  private:
+    struct Observation {
+        BigInt Generation;
+        Vec2L Position;
+    };
+
+    ankerl::unordered_dense::map<const LifeNode*, Observation> m_Observations;
+};
+} // namespace gol
+
+#endif
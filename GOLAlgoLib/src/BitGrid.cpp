@@ -0,0 +1,158 @@
+#include <array>
+#include <bit>
+#include <utility>
+
+#include "BitGrid.hpp"
+
+namespace gol {
+namespace {
+// Adds one bit to each of the 64 four-bit counters held across `sums`.
+void AddBit(std::array<uint64_t, 4>& sums, uint64_t bits) {
+    for (auto& sum : sums) {
+        const auto carry = sum & bits;
+        sum ^= bits;
+        bits = carry;
+    }
+}
+} // namespace
+
+bool BitGrid::Fits(Size2 size) {
+    return size.Width > 0 && size.Height > 0 &&
+           static_cast<int64_t>(size.Width) * size.Height <= MaxCellCount;
+}
+
+bool BitGrid::Prefers(Size2 size, const BigInt& population) {
+    if (!Fits(size)) {
+        return false;
+    }
+    const auto cellCount = static_cast<int64_t>(size.Width) * size.Height;
+    return cellCount <= SmallCellCount ||
+           population * CellsPerLiveCell >= cellCount;
+}
+
+BitGrid::BitGrid(const HashQuadtree& tree, Size2 size, bool wrap)
+    : m_Size(size), m_Wrap(wrap),
+      m_WordsPerRow((static_cast<size_t>(size.Width) + 63) / 64),
+      m_LastWordMask(~uint64_t{0} >> ((64 - size.Width % 64) % 64)),
+      m_Cells(m_WordsPerRow * static_cast<size_t>(size.Height)),
+      m_Next(m_Cells.size()) {
+    for (const auto cell : tree) {
+        if (cell.X < 0 || cell.X >= size.Width || cell.Y < 0 ||
+            cell.Y >= size.Height) {
+            continue;
+        }
+        Word(m_Cells, cell.Y, static_cast<size_t>(cell.X) / 64) |=
+            uint64_t{1} << (cell.X % 64);
+    }
+}
+
+uint64_t& BitGrid::Word(std::vector<uint64_t>& cells, int32_t y,
+                        size_t word) const {
+    return cells[static_cast<size_t>(y) * m_WordsPerRow + word];
+}
+
+bool BitGrid::Get(Vec2 pos) const {
+    if (pos.X < 0 || pos.X >= m_Size.Width || pos.Y < 0 ||
+        pos.Y >= m_Size.Height) {
+        return false;
+    }
+
+    const auto word = m_Cells[static_cast<size_t>(pos.Y) * m_WordsPerRow +
+                              static_cast<size_t>(pos.X) / 64];
+    return ((word >> (pos.X % 64)) & 1) != 0;
+}
+
+void BitGrid::Step(const LifeRule& rule) {
+    for (auto y = 0; y < m_Size.Height; ++y) {
+        StepRow(y, rule);
+    }
+    std::swap(m_Cells, m_Next);
+}
+
+void BitGrid::StepRow(int32_t y, const LifeRule& rule) {
+    const auto rowAt = [&](int32_t row) -> const uint64_t* {
+        if (row < 0 || row >= m_Size.Height) {
+            if (!m_Wrap) {
+                return nullptr;
+            }
+            row = (row + m_Size.Height) % m_Size.Height;
+        }
+        return m_Cells.data() + static_cast<size_t>(row) * m_WordsPerRow;
+    };
+    const std::array rows{rowAt(y - 1), rowAt(y), rowAt(y + 1)};
+
+    const auto lastBit = static_cast<uint32_t>((m_Size.Width - 1) % 64);
+    const auto edgeBit = [&](const uint64_t* row, size_t word, uint32_t bit) {
+        return (row[word] >> bit) & 1;
+    };
+
+    const auto birthMask = rule.StoredBirthMask();
+    const auto surviveMask = rule.StoredSurviveMask();
+    for (auto word = 0UZ; word < m_WordsPerRow; ++word) {
+        const bool lastWord = word + 1 == m_WordsPerRow;
+
+        std::array<uint64_t, 4> sums{};
+        for (auto i = 0UZ; i < rows.size(); ++i) {
+            const auto* row = rows[i];
+            if (!row) {
+                continue;
+            }
+
+            // Bit x of `west` holds the cell at x - 1 and bit x of `east`
+            // the cell at x + 1, carried across word and grid edges.
+            auto west = row[word] << 1U;
+            if (word > 0) {
+                west |= row[word - 1] >> 63U;
+            } else if (m_Wrap) {
+                west |= edgeBit(row, m_WordsPerRow - 1, lastBit);
+            }
+
+            auto east = row[word] >> 1U;
+            if (!lastWord) {
+                east |= row[word + 1] << 63U;
+            } else if (m_Wrap) {
+                east |= edgeBit(row, 0, 0) << lastBit;
+            }
+
+            AddBit(sums, west);
+            AddBit(sums, east);
+            if (i != 1) {
+                AddBit(sums, row[word]);
+            }
+        }
+
+        const auto alive = rows[1][word];
+        uint64_t next = 0;
+        for (auto count = 0; count <= 8; ++count) {
+            const bool born = ((birthMask >> count) & 1) != 0;
+            const bool survives = ((surviveMask >> count) & 1) != 0;
+            if (!born && !survives) {
+                continue;
+            }
+
+            auto matches = ~uint64_t{0};
+            for (auto bit = 0UZ; bit < sums.size(); ++bit) {
+                matches &= ((count >> bit) & 1) != 0 ? sums[bit] : ~sums[bit];
+            }
+            next |= matches & ((born ? ~alive : 0) | (survives ? alive : 0));
+        }
+
+        Word(m_Next, y, word) = lastWord ? next & m_LastWordMask : next;
+    }
+}
+
+HashQuadtree BitGrid::ToQuadtree() const {
+    std::vector<Vec2> cells{};
+    for (auto y = 0; y < m_Size.Height; ++y) {
+        for (auto word = 0UZ; word < m_WordsPerRow; ++word) {
+            auto bits = m_Cells[static_cast<size_t>(y) * m_WordsPerRow + word];
+            while (bits != 0) {
+                const auto bit = std::countr_zero(bits);
+                cells.emplace_back(static_cast<int32_t>(word * 64) + bit, y);
+                bits &= bits - 1;
+            }
+        }
+    }
+    return HashQuadtree{cells};
+}
+} // namespace gol
@@ -9,6 +9,7 @@
 #include <optional>
 #include <random>
 #include <ranges>
+#include <span>
 #include <stop_token>
 #include <type_traits>
 #include <utility>
@@ -18,6 +19,7 @@
 #include "Graphics2D.hpp"
 #include "HashLife.hpp"
 #include "HashQuadtree.hpp"
+#include "LargerThanLife.hpp"
 #include "LifeAlgorithm.hpp"
 #include "LifeHashSet.hpp"
 #include "Plane.hpp"
@@ -142,13 +144,48 @@ std::span<Vec2> GameGrid::SortedData() const {
 
 const HashQuadtree& GameGrid::Data() const { return m_HashLifeData; }
 
-void GameGrid::SetRule(const LifeRule& rule) { m_Algorithm->SetRule(rule); }
+std::expected<void, std::string_view>
+GameGrid::IsValidRule(std::string_view ruleString) {
+    if (LargerThanLifeRule::IsLargerThanLifeRule(ruleString)) {
+        return LargerThanLifeRule::IsValidRule(ruleString);
+    }
+    return LifeRule::IsValidRule(ruleString);
+}
+
+std::expected<Size2, std::string_view>
+GameGrid::ExtractDimensions(std::string_view ruleString) {
+    if (LargerThanLifeRule::IsLargerThanLifeRule(ruleString)) {
+        return LargerThanLifeRule::Make(ruleString).transform([](auto rule) {
+            return rule.Bounds().value_or(Rect{}).Size();
+        });
+    }
+    return LifeRule::ExtractDimensions(ruleString);
+}
+
+void GameGrid::SetRule(const LifeRule& rule) {
+    if (m_Algorithm->GetIdentifier() != HashLife::Identifier) {
+        m_Algorithm = std::make_unique<HashLife>();
+        m_Algorithm->SetTopology(
+            std::make_unique<Plane>(Rect{0, 0, m_Width, m_Height}));
+    }
+    m_Algorithm->SetRule(rule);
+}
 
 void GameGrid::SetRule(const LifeRule& rule, std::string_view ruleString) {
     SetRule(rule);
     m_RuleString = ruleString;
 }
 
+void GameGrid::SetRule(std::string_view ruleString) {
+    if (LargerThanLifeRule::IsLargerThanLifeRule(ruleString)) {
+        m_Algorithm = std::make_unique<LargerThanLife>(
+            *LargerThanLifeRule::Make(ruleString));
+        m_RuleString = ruleString;
+        return;
+    }
+    SetRule(*LifeRule::Make(ruleString), ruleString);
+}
+
 std::string_view GameGrid::GetRuleString() const { return m_RuleString; }
 
 BigInt GameGrid::Update(const BigInt& numSteps, std::stop_token stopToken) {
@@ -187,10 +224,22 @@ bool GameGrid::Set(int32_t x, int32_t y, bool active) {
     return true;
 }
 
+void GameGrid::SetMany(std::span<const Vec2> positions, bool active) {
+    const auto inBounds = [this](Vec2 pos) { return InBounds(pos); };
+    if (std::ranges::all_of(positions, inBounds)) {
+        m_HashLifeData.SetMany(positions, active);
+    } else {
+        const auto kept = positions | std::views::filter(inBounds) |
+                          std::ranges::to<std::vector>();
+        m_HashLifeData.SetMany(kept, active);
+    }
+    m_SortedCacheInvalidated = true;
+}
+
 GameGrid GameGrid::SubRegion(Rect region) const {
     auto subRegion = GameGrid{m_HashLifeData.Extract(region), region.Size()};
-    if (const auto rule = LifeRule::Make(m_RuleString); rule) {
-        subRegion.SetRule(*rule, m_RuleString);
+    if (IsValidRule(m_RuleString)) {
+        subRegion.SetRule(m_RuleString);
     }
     return subRegion;
 }
@@ -206,50 +255,26 @@ void GameGrid::InsertGrid(const GameGrid& region, Vec2 pos) {
 }
 
 void GameGrid::RotateGrid(bool clockwise) {
-    // Probably more easily read as ((width - 1) / 2, (height - 1) / 2)
-    const Vec2F center{((m_Width / 2.f) - 0.5f), ((m_Height / 2.f) - 0.5F)};
-    std::vector<Vec2> newSet{};
-    newSet.reserve(Population().convert_to<size_t>());
-
-    for (const auto cellPos : m_HashLifeData) {
-        const auto offset = Vec2F{static_cast<float>(cellPos.X),
-                                  static_cast<float>(cellPos.Y)} -
-                            center;
-        const auto rotated =
-            clockwise ? Vec2F{-offset.Y, offset.X} : Vec2F{offset.Y, -offset.X};
-        const auto result = rotated + Vec2F{center.Y, center.X};
-        newSet.emplace_back(static_cast<int32_t>(result.X),
-                            static_cast<int32_t>(result.Y));
-    }
+    // Rotating about the origin leaves the grid one width or height away
+    // from where it started.
+    m_HashLifeData.Rotate90(clockwise);
+    m_HashLifeData.Translate(clockwise ? Vec2L{m_Height, 0}
+                                       : Vec2L{0, m_Width});
     std::swap(m_Width, m_Height);
     m_SortedCacheInvalidated = true;
-
-    m_HashLifeData = HashQuadtree{newSet};
 }
 
 void GameGrid::FlipGrid(bool vertical) {
-    std::vector<Vec2> newData{};
-    newData.reserve(Population().convert_to<size_t>());
+    // Unbounded grids flip about the axis through the origin's cell, and
+    // bounded ones about their center.
+    m_HashLifeData.Flip(vertical);
     if (!Bounded()) {
-        for (const auto pos : m_HashLifeData) {
-            if (vertical) {
-                newData.emplace_back(pos.X, -pos.Y);
-            } else {
-                newData.emplace_back(-pos.X, pos.Y);
-            }
-        }
+        m_HashLifeData.Translate(vertical ? Vec2L{0, 1} : Vec2L{1, 0});
     } else {
-        for (const auto pos : m_HashLifeData) {
-            if (vertical) {
-                newData.emplace_back(pos.X, m_Height - 1 - pos.Y);
-            } else {
-                newData.emplace_back(m_Width - 1 - pos.X, pos.Y);
-            }
-        }
+        m_HashLifeData.Translate(vertical ? Vec2L{0, m_Height}
+                                         : Vec2L{m_Width, 0});
     }
     m_SortedCacheInvalidated = true;
-
-    m_HashLifeData = HashQuadtree{newData};
 }
 
 std::optional<bool> GameGrid::Get(int32_t x, int32_t y) const {
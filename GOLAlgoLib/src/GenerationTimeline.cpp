@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <stop_token>
+
+#include "GenerationTimeline.hpp"
+
+namespace gol {
+
+GenerationTimeline::GenerationTimeline(const BigInt& interval, size_t capacity)
+    : m_MinInterval(std::max(interval, BigOne)), m_Interval(m_MinInterval),
+      m_Capacity(std::max(capacity, 2UZ)) {}
+
+void GenerationTimeline::SetInterval(const BigInt& interval) {
+    const auto clamped = std::max(interval, BigOne);
+    if (clamped == m_MinInterval)
+        return;
+    m_MinInterval = clamped;
+    m_Interval = std::max(m_Interval, m_MinInterval);
+}
+
+void GenerationTimeline::Record(const GameGrid& grid) {
+    if (!m_Checkpoints.empty() &&
+        grid.Generation() < m_Checkpoints.back().Generation() + m_Interval)
+        return;
+
+    m_Checkpoints.push_back(grid);
+    if (m_Checkpoints.size() > m_Capacity)
+        Thin();
+}
+
+void GenerationTimeline::Branch(const GameGrid& grid) {
+    const auto first =
+        std::ranges::find_if(m_Checkpoints, [&](const GameGrid& checkpoint) {
+            return checkpoint.Generation() >= grid.Generation();
+        });
+    m_Checkpoints.erase(first, m_Checkpoints.end());
+
+    m_Checkpoints.push_back(grid);
+    if (m_Checkpoints.size() > m_Capacity)
+        Thin();
+}
+
+void GenerationTimeline::Clear() {
+    m_Checkpoints.clear();
+    m_Interval = m_MinInterval;
+}
+
+const GameGrid* GenerationTimeline::Nearest(const BigInt& generation) const {
+    // Checkpoints are recorded in increasing generation order.
+    const auto after = std::upper_bound(
+        m_Checkpoints.begin(), m_Checkpoints.end(), generation,
+        [](const BigInt& target, const GameGrid& checkpoint) {
+            return target < checkpoint.Generation();
+        });
+    if (after == m_Checkpoints.begin())
+        return nullptr;
+    return &*std::prev(after);
+}
+
+std::optional<GameGrid>
+GenerationTimeline::Rewind(const BigInt& generation,
+                           std::stop_token stopToken) const {
+    const auto* checkpoint = Nearest(generation);
+    if (!checkpoint)
+        return std::nullopt;
+
+    GameGrid result{*checkpoint};
+    if (const auto remaining = generation - result.Generation();
+        !remaining.is_zero()) {
+        result.Update(remaining, stopToken);
+        if (stopToken.stop_requested())
+            return std::nullopt;
+    }
+    return result;
+}
+
+void GenerationTimeline::Thin() {
+    // Keeps the first checkpoint and every other one after it, so the start
+    // of the run always stays reachable.
+    auto kept = 1UZ;
+    for (auto i = 2UZ; i < m_Checkpoints.size(); i += 2UZ)
+        m_Checkpoints[kept++] = std::move(m_Checkpoints[i]);
+    m_Checkpoints.resize(kept);
+    m_Interval *= 2;
+}
+} // namespace gol
@@ -1,6 +1,8 @@
 #include "HashLife.hpp"
 #include "Plane.hpp"
+#include "Profiler.hpp"
 #include "Torus.hpp"
+#include "Tracing.hpp"
 
 namespace gol {
 namespace {
@@ -159,16 +161,17 @@ uint16_t WindowCenter(uint16_t nw, uint16_t ne, uint16_t sw, uint16_t se) {
 
 HashLife::FirstGenResults
 HashLife::ComputeFirstGeneration(const LeafQuadrants& q) const {
+    const auto& table = s_PhaseTables[s_Phase];
     return {
-        s_Rule.Table()[q.nw],
-        s_Rule.Table()[WindowN(q.nw, q.ne)],
-        s_Rule.Table()[q.ne],
-        s_Rule.Table()[WindowW(q.nw, q.sw)],
-        s_Rule.Table()[WindowCenter(q.nw, q.ne, q.sw, q.se)],
-        s_Rule.Table()[WindowE(q.ne, q.se)],
-        s_Rule.Table()[q.sw],
-        s_Rule.Table()[WindowS(q.sw, q.se)],
-        s_Rule.Table()[q.se],
+        table[q.nw],
+        table[WindowN(q.nw, q.ne)],
+        table[q.ne],
+        table[WindowW(q.nw, q.sw)],
+        table[WindowCenter(q.nw, q.ne, q.sw, q.se)],
+        table[WindowE(q.ne, q.se)],
+        table[q.sw],
+        table[WindowS(q.sw, q.se)],
+        table[q.se],
     };
 }
 
@@ -226,18 +229,15 @@ const LifeNode* HashLife::AdvanceBase(const HashQuadtree& data,
 
     // Second generation: combine adjacent 2x2 results into four overlapping
     // 4x4 windows, look up each to get a 2x2 result, then assemble.
+    const auto& table = s_PhaseTables[s_Phase ^ 1];
     const auto secondGenNW =
-        s_Rule
-            .Table()[Combine2x2ForLookup(gen1.nw, gen1.n, gen1.w, gen1.center)];
+        table[Combine2x2ForLookup(gen1.nw, gen1.n, gen1.w, gen1.center)];
     const auto secondGenNE =
-        s_Rule
-            .Table()[Combine2x2ForLookup(gen1.n, gen1.ne, gen1.center, gen1.e)];
+        table[Combine2x2ForLookup(gen1.n, gen1.ne, gen1.center, gen1.e)];
     const auto secondGenSW =
-        s_Rule
-            .Table()[Combine2x2ForLookup(gen1.w, gen1.center, gen1.sw, gen1.s)];
+        table[Combine2x2ForLookup(gen1.w, gen1.center, gen1.sw, gen1.s)];
     const auto secondGenSE =
-        s_Rule
-            .Table()[Combine2x2ForLookup(gen1.center, gen1.e, gen1.s, gen1.se)];
+        table[Combine2x2ForLookup(gen1.center, gen1.e, gen1.s, gen1.se)];
 
     const auto resultBits =
         AssembleQuadrants(secondGenNW, secondGenNE, secondGenSW, secondGenSE);
@@ -283,6 +283,8 @@ NodeUpdateInfo HashLife::AdvanceSlow(const HashQuadtree& data,
     // the result of advancing the original node. Unlike HashQuadtree, we're
     // only making recursive calls one level down, and thus have more
     // fine-grained control over how many generations we advance.
+    GOL_TRACE_ZONE_IF("HashLife::AdvanceSlow",
+                      level >= s_JumpDepth - TracedLevels);
 
     if (node == FalseNode)
         return {FalseNode, 0};
@@ -299,13 +301,12 @@ NodeUpdateInfo HashLife::AdvanceSlow(const HashQuadtree& data,
             return {node, 0};
         }
         // Store under the requested maxAdvance so the same request hits.
-        s_SlowCache[{node, advanceLevel}] = result;
+        data.CacheSlowResult({node, advanceLevel}, s_Phase, result);
         // Also store under the actual generations for cross-request reuse.
         return {result, actualLevel};
     }
-    if (const auto it = s_SlowCache.find({node, advanceLevel});
-        it != s_SlowCache.end()) {
-        return {it->second, advanceLevel};
+    if (const auto result = data.FindSlow({node, advanceLevel}, s_Phase)) {
+        return {*result, advanceLevel};
     }
 
     constexpr static auto subdivisions = 8;
@@ -375,7 +376,7 @@ NodeUpdateInfo HashLife::AdvanceSlow(const HashQuadtree& data,
     }
 
     // Store under the requested maxAdvance so the same request hits next time.
-    s_SlowCache[{node, advanceLevel}] = combined;
+    data.CacheSlowResult({node, advanceLevel}, s_Phase, combined);
     return {combined, newAdvanceLevel};
 }
 
@@ -392,10 +393,14 @@ NodeUpdateInfo HashLife::AdvanceFast(const HashQuadtree& data,
     // quadrants of the center node that is half the size. THe key to this
     // process is that the two levels are made by recursively calling
     // AdvanceFast, which allows for logarithmic time progression.
+    GOL_TRACE_ZONE_IF("HashLife::AdvanceFast",
+                      level >= s_JumpDepth - TracedLevels);
 
     if (node == FalseNode)
         return {FalseNode, 0};
 
+    // Only even generations are ever advanced by more than one generation at
+    // a time, so the node map only ever holds results for the even phase.
     if (const auto result = data.Find(node)) {
         return {*result, level - 2};
     }
@@ -535,26 +540,35 @@ std::string_view HashLife::Identifier = "HashLife";
 
 thread_local LifeRule HashLife::s_Rule = *LifeRule::Make("B3/S23");
 
-// The cache for the HashLife algorithm when the step size is bounded.
-thread_local ankerl::unordered_dense::map<SlowKey, const LifeNode*, SlowHash>
-    HashLife::s_SlowCache{};
+thread_local std::array<LifeRule::LookupTable, 2> HashLife::s_PhaseTables{
+    s_Rule.Table(), s_Rule.Table()};
 
-HashLife::HashLife() : m_Topology(std::make_unique<Plane>()) {
-    // Reserve space for 1 million nodes to avoid rehashing
-    // during early stages of the simulation.
-    s_SlowCache.reserve(std::max(s_SlowCache.size(), 1UZ << 20UZ));
+thread_local int32_t HashLife::s_Phase = 0;
+thread_local int32_t HashLife::s_JumpDepth = 0;
+
+namespace {
+const std::shared_ptr<const LifeRule>& DefaultRule() {
+    static const auto rule =
+        std::make_shared<const LifeRule>(*LifeRule::Make("B3/S23"));
+    return rule;
 }
+} // namespace
+
+HashLife::HashLife()
+    : m_Topology(std::make_unique<Plane>()), m_Rule(DefaultRule()) {}
 
 HashLife::HashLife(std::unique_ptr<Topology> topology)
-    : m_Topology(std::move(topology)) {}
+    : m_Topology(std::move(topology)), m_Rule(DefaultRule()) {}
 
 void HashLife::SetTopology(std::unique_ptr<Topology> topology) {
     m_Topology = std::move(topology);
+    m_BoundedGrid.reset();
 }
 
 void HashLife::SetRule(const LifeRule& rule) {
-    s_Rule = rule;
-    s_SlowCache.clear();
+    m_Rule = std::make_shared<const LifeRule>(rule);
+    BindRule();
+    m_BoundedGrid.reset();
 
     if (rule.Bounds()) {
         m_Topology = [&] -> std::unique_ptr<Topology> {
@@ -577,34 +591,120 @@ bool HashLife::CompatibleWith(const LifeDataStructure& data) const {
 std::string_view HashLife::GetIdentifier() const { return "HashLife"; }
 
 std::unique_ptr<LifeAlgorithm> HashLife::Clone() const {
-    return std::make_unique<HashLife>(m_Topology->Clone());
+    auto clone = std::make_unique<HashLife>(m_Topology->Clone());
+    clone->m_Rule = m_Rule;
+    return clone;
+}
+
+void HashLife::BindRule() const {
+    if (s_Rule.Fingerprint() == m_Rule->Fingerprint())
+        return;
+    s_Rule = *m_Rule;
+    s_PhaseTables = {s_Rule.PhaseTable(0), s_Rule.PhaseTable(1)};
 }
 
 BigInt HashLife::Step(LifeDataStructure& data, const BigInt& numSteps,
                       std::stop_token stopToken) {
     auto& hashQuadtree = dynamic_cast<HashQuadtree&>(data);
+    BindRule();
+    hashQuadtree.AdoptNodes();
+
+    ScopedTimer timer{ProfileMetric::HashLifeStep};
+    const auto nodesBefore = HashQuadtree::CreatedNodeCount();
+    const auto generations = StepImpl(hashQuadtree, numSteps, stopToken);
+
+    auto& profiler = Profiler::Get();
+    profiler.AddCount(ProfileMetric::NodesCreated,
+                      HashQuadtree::CreatedNodeCount() - nodesBefore);
+    profiler.SetBytes(ProfileMetric::CacheMemory,
+                      HashQuadtree::CacheMemoryUsage());
+    return generations;
+}
+
+BigInt HashLife::StepImpl(HashQuadtree& hashQuadtree, const BigInt& numSteps,
+                          std::stop_token stopToken) {
+    if (const auto bounds = m_Topology->GetBounds();
+        bounds &&
+        BitGrid::Prefers(bounds->Size(), hashQuadtree.Population())) {
+        return StepBounded(hashQuadtree, *bounds, numSteps, stopToken);
+    }
 
-    if (numSteps.is_zero())
+    // Complemented rules keep one phase for every generation, so only the
+    // other B0 rules alternate.
+    const bool birthOnZero =
+        s_Rule.HasBirthOnZero() && !s_Rule.IsComplemented();
+
+    // Results are cached per rule, so returning to an earlier rule picks up
+    // where it left off.
+    HashQuadtree::SetRuleFingerprint(s_Rule.Fingerprint());
+    s_Phase = 0;
+    if (numSteps.is_zero() && !(birthOnZero && m_Topology->GetBounds()))
         return BigPow2(DoOneJump(
             hashQuadtree, m_Topology->Log2MaxIncrement(numSteps), stopToken));
 
+    // Odd generations of a B0 rule are stored complemented, so those rules
+    // always advance by an even number of generations. Unbounded topologies
+    // then only ever take even jumps, while bounded ones alternate phases
+    // one generation at a time.
+    const auto targetSteps = [&] -> BigInt {
+        if (!birthOnZero)
+            return numSteps;
+        if (numSteps.is_zero())
+            return 2;
+        return bit_test(numSteps, 0) ? numSteps + 1 : numSteps;
+    }();
+
     BigInt generation{};
-    while (generation < numSteps) {
+    while (generation < targetSteps) {
+        s_Phase = birthOnZero && bit_test(generation, 0) ? 1 : 0;
+        if (s_Phase == 0 && stopToken.stop_requested())
+            return generation;
+
         const auto advanceLevel =
-            m_Topology->Log2MaxIncrement(numSteps - generation);
+            m_Topology->Log2MaxIncrement(targetSteps - generation);
 
+        // A stop request cannot leave a B0 universe on an odd generation.
+        const auto jumpToken = s_Phase == 0 ? stopToken : std::stop_token{};
         const auto gens =
-            BigPow2(DoOneJump(hashQuadtree, advanceLevel, stopToken));
-        if (stopToken.stop_requested())
+            BigPow2(DoOneJump(hashQuadtree, advanceLevel, jumpToken));
+        if (s_Phase == 0 && stopToken.stop_requested())
             return generation;
         generation += gens;
     }
+    s_Phase = 0;
+
+    return generation;
+}
+
+BigInt HashLife::StepBounded(HashQuadtree& data, Rect bounds,
+                             const BigInt& numSteps,
+                             std::stop_token stopToken) {
+    // The grid holds every cell of the universe, so B0 rules need no
+    // alternating phases here. Complemented rules still step the stored
+    // complement, through the rule's stored masks.
+    if (!m_BoundedGrid || m_BoundedRoot != data.Data() ||
+        m_BoundedSeedOffset != data.SeedOffset() ||
+        m_BoundedGrid->Size() != bounds.Size()) {
+        m_BoundedGrid.emplace(data, bounds.Size(),
+                              typeid(*m_Topology) == typeid(Torus));
+    }
+
+    const auto targetSteps = numSteps.is_zero() ? BigOne : numSteps;
+    BigInt generation{};
+    while (generation < targetSteps && !stopToken.stop_requested()) {
+        m_BoundedGrid->Step(s_Rule);
+        ++generation;
+    }
 
+    data = m_BoundedGrid->ToQuadtree();
+    m_BoundedRoot = data.Data();
+    m_BoundedSeedOffset = data.SeedOffset();
     return generation;
 }
 
 int32_t HashLife::DoOneJump(HashQuadtree& data, int32_t advanceLevel,
                             std::stop_token stopToken) {
+    GOL_TRACE_ZONE("HashLife::DoOneJump");
     if (data.Data() == FalseNode)
         return {};
 
@@ -621,6 +721,7 @@ int32_t HashLife::DoOneJump(HashQuadtree& data, int32_t advanceLevel,
         root = data.ExpandNode(root, depth);
         depth++;
     }
+    s_JumpDepth = depth;
 
     const auto advanced =
         AdvanceNode(data, stopToken, root, depth, advanceLevel);
@@ -1,16 +1,20 @@
 #include <algorithm>
 #include <ankerl/unordered_dense.h>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <concepts>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <print>
 #include <ranges>
+#include <shared_mutex>
 #include <span>
 #include <stop_token>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "Graphics2D.hpp"
@@ -18,21 +22,127 @@
 #include "LifeAlgorithm.hpp"
 #include "LifeHashSet.hpp"
 #include "LifeRule.hpp"
+#include "Tracing.hpp"
 
 namespace gol {
 constexpr static auto ViewportMaxLevel = 31;
 
-HashLifeCache::HashLifeCache() {
-    EmptyNodeCache.resize(64, nullptr);
-    NodeMap.reserve(1UZ << 20UZ);
+namespace {
+// Locks a shared or borrowed cache for reading. Caches used by one thread are
+// not locked.
+std::shared_lock<std::shared_mutex> ReadLock(HashLifeCache& cache) {
+    if (!cache.NeedsLocking())
+        return {};
+    return std::shared_lock{cache.Mutex};
 }
 
-std::array<HashLifeCache, HashQuadtree::MaxCacheCount> HashQuadtree::s_Cache{};
+// Locks a shared or borrowed cache for writing. Caches used by one thread are
+// not locked.
+std::unique_lock<std::shared_mutex> WriteLock(HashLifeCache& cache) {
+    if (!cache.NeedsLocking())
+        return {};
+    return std::unique_lock{cache.Mutex};
+}
+
+bool IsEmptyNode(const LifeNode* node) {
+    return node == FalseNode || node->IsEmpty;
+}
+
+// Whether two nodes of the same level hold the same cells. Nodes from one
+// cache are canonical, so this only descends into nodes from different
+// caches.
+bool SameCells(const LifeNode* a, const LifeNode* b) {
+    if (a == b)
+        return true;
+    if (IsEmptyNode(a) || IsEmptyNode(b))
+        return IsEmptyNode(a) && IsEmptyNode(b);
+    // Every live level 0 node is TrueNode, so a and b are not leaves.
+    if (a == TrueNode || b == TrueNode || a->Population != b->Population)
+        return false;
+
+    return SameCells(a->NorthWest, b->NorthWest) &&
+           SameCells(a->NorthEast, b->NorthEast) &&
+           SameCells(a->SouthWest, b->SouthWest) &&
+           SameCells(a->SouthEast, b->SouthEast);
+}
+
+using PlacedNode = std::pair<Vec2L, const LifeNode*>;
+
+// Appends the non-empty nodes of `targetLevel` below `node`.
+void CollectNodes(std::vector<PlacedNode>& result, const LifeNode* node,
+                  Vec2L pos, int32_t level, int32_t targetLevel) {
+    if (IsEmptyNode(node))
+        return;
+
+    if (level == targetLevel) {
+        result.emplace_back(pos, node);
+        return;
+    }
+
+    const auto childLevel = level - 1;
+    const auto halfSize = Pow2(childLevel);
+    CollectNodes(result, node->NorthWest, pos, childLevel, targetLevel);
+    CollectNodes(result, node->NorthEast, {pos.X + halfSize, pos.Y},
+                 childLevel, targetLevel);
+    CollectNodes(result, node->SouthWest, {pos.X, pos.Y + halfSize},
+                 childLevel, targetLevel);
+    CollectNodes(result, node->SouthEast, {pos.X + halfSize, pos.Y + halfSize},
+                 childLevel, targetLevel);
+}
+} // namespace
+
+RuleResultCache::RuleResultCache(size_t slowCapacity)
+    : SlowResults{SlowResultCache{slowCapacity},
+                  SlowResultCache{slowCapacity}} {}
+
+std::shared_ptr<RuleResultCache>
+HashLifeCache::ResultsFor(uint64_t fingerprint) {
+    auto& results = RuleResults[fingerprint];
+    if (results == nullptr) {
+        results = std::make_shared<RuleResultCache>(SlowCacheCapacity);
+    }
+    results->LastUsed = ++RuleUseCount;
+
+    if (RuleResults.size() > MaxRuleCount) {
+        const auto stalest = std::ranges::min_element(
+            RuleResults, {},
+            [](const auto& entry) { return entry.second->LastUsed; });
+        // Erasing may move entries, but never the caches they point to.
+        RuleResults.erase(stalest);
+    }
+
+    return RuleResults[fingerprint];
+}
+
+void HashLifeCache::Reset() {
+    NodeStorage = std::make_shared<LifeNodeArena>();
+    NodeSet = {};
+    EmptyNodeCache = {};
+    RuleResults = {};
+    RuleUseCount = 0;
+    SlowCacheCapacity =
+        DefaultSlowCacheBudget / RuleResultCache::SlowEntryBytes;
+    Shared = false;
+    Concurrent = false;
+    Generation.fetch_add(1, std::memory_order_release);
+}
+
+std::mutex HashQuadtree::s_CacheMutex{};
+std::vector<std::unique_ptr<HashLifeCache>> HashQuadtree::s_Caches{};
+std::vector<size_t> HashQuadtree::s_FreeCaches{};
+size_t HashQuadtree::s_SharedCache{};
+size_t HashQuadtree::s_SharedCacheUsers{};
 
 thread_local ankerl::unordered_dense::map<const LifeNode*, BigInt, LifeNodeHash,
                                           LifeNodeEqual>
     HashQuadtree::s_PopulationCache{};
+thread_local uint64_t HashQuadtree::s_PopulationArenas{};
 thread_local size_t HashQuadtree::s_CacheIndex{};
+thread_local HashLifeCache* HashQuadtree::s_ActiveCache{};
+thread_local uint64_t HashQuadtree::s_ActiveGeneration{};
+thread_local uint64_t HashQuadtree::s_RuleFingerprint{};
+thread_local std::shared_ptr<RuleResultCache>
+    HashQuadtree::s_ActiveResults{};
 
 // Mixes the node's precomputed hash with MaxAdvance. The node hash is already
 // well-distributed via splitmix64, so a single round of xor-shift mixing with
@@ -72,9 +182,154 @@ HashQuadtree::HashQuadtree(std::span<const Vec2> data, Vec2 offset) {
     m_SeedOffset +=
         {static_cast<int64_t>(offset.X), static_cast<int64_t>(offset.Y)};
     ExpandUniverse(4);
+    // Deep trees skip the expansion, but still hold the arena.
+    AdoptNodes();
 }
 
-void HashQuadtree::SetCacheIndex(size_t index) { s_CacheIndex = index; }
+void HashQuadtree::SetCacheIndex(size_t index) {
+    s_CacheIndex = index;
+    s_ActiveCache = nullptr;
+    s_ActiveResults = nullptr;
+}
+
+size_t HashQuadtree::AcquireCache() {
+    std::scoped_lock lock{s_CacheMutex};
+    return NextFreeCache();
+}
+
+size_t HashQuadtree::AcquireSharedCache() {
+    std::scoped_lock lock{s_CacheMutex};
+    if (s_SharedCacheUsers++ > 0)
+        return s_SharedCache;
+
+    // Created up front, since it must be marked before any thread uses it.
+    s_SharedCache = NextFreeCache();
+    auto& cache = s_Caches[s_SharedCache];
+    if (cache == nullptr) {
+        cache = std::make_unique<HashLifeCache>();
+    }
+    cache->Shared = true;
+    return s_SharedCache;
+}
+
+size_t HashQuadtree::NextFreeCache() {
+    if (!s_FreeCaches.empty()) {
+        const auto index = s_FreeCaches.back();
+        s_FreeCaches.pop_back();
+        return index;
+    }
+
+    // Index 0 is the default cache of threads that never pick one.
+    const auto index = std::max(1UZ, s_Caches.size());
+    s_Caches.resize(index + 1);
+    return index;
+}
+
+void HashQuadtree::ReleaseCache(size_t index) {
+    std::scoped_lock lock{s_CacheMutex};
+    if (index == s_SharedCache && index != 0) {
+        if (--s_SharedCacheUsers > 0)
+            return;
+        s_SharedCache = 0;
+    }
+
+    if (index < s_Caches.size() && s_Caches[index] != nullptr) {
+        // Nodes stay allocated until the last tree holding them, such as one
+        // queued for rasterization, lets go of the old arena. Threads still
+        // pointing at the cache notice the new generation on their next use.
+        s_Caches[index]->Reset();
+    }
+    s_FreeCaches.push_back(index);
+}
+
+void HashQuadtree::SetCacheConcurrent(size_t index, bool concurrent) {
+    std::scoped_lock lock{s_CacheMutex};
+    if (index >= s_Caches.size()) {
+        s_Caches.resize(index + 1);
+    }
+    auto& cache = s_Caches[index];
+    if (cache == nullptr) {
+        cache = std::make_unique<HashLifeCache>();
+    }
+    cache->Concurrent.store(concurrent, std::memory_order_release);
+}
+
+HashLifeCache& HashQuadtree::ActiveCache() {
+    if (s_ActiveCache == nullptr) {
+        std::scoped_lock lock{s_CacheMutex};
+        if (s_CacheIndex >= s_Caches.size()) {
+            s_Caches.resize(s_CacheIndex + 1);
+        }
+
+        // Caches are only created once used, and never move once created.
+        auto& cache = s_Caches[s_CacheIndex];
+        if (cache == nullptr) {
+            cache = std::make_unique<HashLifeCache>();
+        }
+        s_ActiveCache = cache.get();
+        s_ActiveGeneration =
+            s_ActiveCache->Generation.load(std::memory_order_acquire);
+    } else if (const auto generation =
+                   s_ActiveCache->Generation.load(std::memory_order_acquire);
+               generation != s_ActiveGeneration) {
+        // Another thread released the cache since this one last used it, so
+        // the results held for it belong to nodes that are gone.
+        s_ActiveGeneration = generation;
+        s_ActiveResults = nullptr;
+    }
+    return *s_ActiveCache;
+}
+
+void HashQuadtree::SetRuleFingerprint(uint64_t fingerprint) {
+    auto& cache = ActiveCache();
+    if (s_ActiveResults == nullptr || fingerprint != s_RuleFingerprint) {
+        s_RuleFingerprint = fingerprint;
+        const auto lock = WriteLock(cache);
+        s_ActiveResults = cache.ResultsFor(fingerprint);
+    }
+}
+
+RuleResultCache& HashQuadtree::ActiveResults() {
+    // Resolved first, since it drops results from before a reset.
+    auto& cache = ActiveCache();
+    if (s_ActiveResults == nullptr) {
+        const auto lock = WriteLock(cache);
+        s_ActiveResults = cache.ResultsFor(s_RuleFingerprint);
+    }
+    return *s_ActiveResults;
+}
+
+void HashQuadtree::AdoptNodes() {
+    const auto& arena = ActiveCache().NodeStorage;
+    if (m_Arena == arena) {
+        return;
+    }
+    if (IsForeign(m_Root, arena->Id())) {
+        ImportMemo memo{};
+        m_Root = ImportNode(m_Root, memo);
+    }
+    m_Arena = arena;
+}
+
+bool HashQuadtree::IsForeign(const LifeNode* node, uint32_t arena) {
+    return node != FalseNode && node->Arena != 0 && node->Arena != arena;
+}
+
+const LifeNode* HashQuadtree::ImportNode(const LifeNode* node,
+                                         ImportMemo& memo) const {
+    if (!IsForeign(node, ActiveCache().NodeStorage->Id())) {
+        return node;
+    }
+    if (const auto it = memo.find(node); it != memo.end()) {
+        return it->second;
+    }
+
+    const auto* imported = FindOrCreate(
+        ImportNode(node->NorthWest, memo), ImportNode(node->NorthEast, memo),
+        ImportNode(node->SouthWest, memo), ImportNode(node->SouthEast, memo));
+    memo.emplace(node, imported);
+    return imported;
+}
 
 const LifeNode* HashQuadtree::Data() const { return m_Root; }
 
@@ -87,20 +342,104 @@ void HashQuadtree::OverwriteData(const LifeNode* root, int32_t level,
 void HashQuadtree::OverwriteData(const LifeNode* root, int32_t level) {
     m_Root = root;
     m_Depth = level;
+    if (const auto& arena = ActiveCache().NodeStorage;
+        m_Root != FalseNode && m_Root->Arena == arena->Id()) {
+        m_Arena = arena;
+    }
 }
 
 int32_t HashQuadtree::CalculateDepth() const { return m_Depth; }
 
-// TODO: Improve efficiency of equality comparison
+Vec2L HashQuadtree::SeedOffset() const { return m_SeedOffset; }
+
+Vec2L HashQuadtree::RootPosition() const {
+    const auto half = (m_Depth == 0 ? 0 : Pow2(m_Depth - 1));
+    return {m_SeedOffset.X - half, m_SeedOffset.Y - half};
+}
+
+std::optional<HashQuadtree::CoreNode> HashQuadtree::Core() const {
+    if (IsEmptyNode(m_Root))
+        return CoreNode{FalseNode, 0, {}};
+    if (m_Depth > MaxNodeWalkDepth)
+        return std::nullopt;
+
+    CoreNode core{m_Root, m_Depth, RootPosition()};
+    while (core.Level > 0) {
+        const auto childLevel = core.Level - 1;
+        const auto halfSize = Pow2(childLevel);
+        const std::array<PlacedNode, 4> children{{
+            {{0, 0}, core.Node->NorthWest},
+            {{halfSize, 0}, core.Node->NorthEast},
+            {{0, halfSize}, core.Node->SouthWest},
+            {{halfSize, halfSize}, core.Node->SouthEast},
+        }};
+
+        const PlacedNode* only = nullptr;
+        auto nonEmptyCount = 0;
+        for (const auto& child : children) {
+            if (!IsEmptyNode(child.second)) {
+                only = &child;
+                ++nonEmptyCount;
+            }
+        }
+        if (nonEmptyCount != 1)
+            break;
+
+        core = {only->second, childLevel, core.Position + only->first};
+    }
+    return core;
+}
+
 bool HashQuadtree::operator==(const HashQuadtree& other) const {
     if (m_Root == other.m_Root && m_SeedOffset == other.m_SeedOffset) {
         return true;
     }
 
-    const auto hashSet1 = *this | std::ranges::to<LifeHashSet>();
-    const auto hashSet2 = other | std::ranges::to<LifeHashSet>();
+    const auto core = Core();
+    const auto otherCore = other.Core();
+    if (!core || !otherCore) {
+        const auto hashSet1 = *this | std::ranges::to<LifeHashSet>();
+        const auto hashSet2 = other | std::ranges::to<LifeHashSet>();
+        return hashSet1 == hashSet2;
+    }
+
+    if (core->Node == FalseNode || otherCore->Node == FalseNode)
+        return core->Node == otherCore->Node;
+
+    if (core->Level == otherCore->Level &&
+        core->Position == otherCore->Position) {
+        return SameCells(core->Node, otherCore->Node);
+    }
+
+    // The finest level at which both trees split space into the same squares.
+    const auto shift = RootPosition() - other.RootPosition();
+    const auto aligned = std::min(
+        {std::countr_zero(static_cast<uint64_t>(shift.X)),
+         std::countr_zero(static_cast<uint64_t>(shift.Y)), m_Depth,
+         other.m_Depth});
 
-    return hashSet1 == hashSet2;
+    // Where the squares line up at both cores' levels, equal cells would have
+    // led both trees down to the same core.
+    if (aligned >= std::max(core->Level, otherCore->Level))
+        return false;
+
+    // Otherwise, compare the non-empty squares of a level both trees share.
+    const auto level = std::min({aligned, core->Level, otherCore->Level});
+    std::vector<PlacedNode> nodes{};
+    std::vector<PlacedNode> otherNodes{};
+    CollectNodes(nodes, core->Node, core->Position, core->Level, level);
+    CollectNodes(otherNodes, otherCore->Node, otherCore->Position,
+                 otherCore->Level, level);
+    if (nodes.size() != otherNodes.size())
+        return false;
+
+    std::ranges::sort(nodes, {}, &PlacedNode::first);
+    std::ranges::sort(otherNodes, {}, &PlacedNode::first);
+    return std::ranges::equal(nodes, otherNodes,
+                              [](const auto& lhs, const auto& rhs) {
+                                  return lhs.first == rhs.first &&
+                                         SameCells(lhs.second, rhs.second);
+                              });
 }
 
 bool HashQuadtree::operator!=(const HashQuadtree& other) const {
@@ -108,6 +447,7 @@ bool HashQuadtree::operator!=(const HashQuadtree& other) const {
 }
 
 void HashQuadtree::Set(Vec2 targetPos, bool alive) {
+    AdoptNodes();
     const auto expansionNeeded = [&] {
         if (m_Depth == 0) {
             return true;
@@ -133,10 +473,91 @@ void HashQuadtree::Set(Vec2 targetPos, bool alive) {
     m_Root = SetCenteredNode(m_Root, m_Depth, centered, insertLevel);
 }
 
+void HashQuadtree::SetMany(std::span<const Vec2> positions, bool alive) {
+    if (positions.empty())
+        return;
+    AdoptNodes();
+
+    auto minX = std::numeric_limits<int64_t>::max();
+    auto maxX = std::numeric_limits<int64_t>::min();
+    auto minY = std::numeric_limits<int64_t>::max();
+    auto maxY = std::numeric_limits<int64_t>::min();
+    std::vector<Vec2L> cells{};
+    cells.reserve(positions.size());
+    for (const auto pos : positions) {
+        minX = std::min<int64_t>(minX, pos.X);
+        maxX = std::max<int64_t>(maxX, pos.X);
+        minY = std::min<int64_t>(minY, pos.Y);
+        maxY = std::max<int64_t>(maxY, pos.Y);
+        cells.emplace_back(pos.X, pos.Y);
+    }
+
+    const auto expansionNeeded = [&] {
+        if (m_Depth == 0) {
+            return true;
+        }
+
+        const auto [left, top] = RootPosition();
+        const auto size = Pow2(m_Depth);
+        return minX < left || maxX >= left + size || minY < top ||
+               maxY >= top + size;
+    };
+
+    while (expansionNeeded()) {
+        m_Root = ExpandNode(m_Root, m_Depth);
+        m_Depth++;
+    }
+
+    const auto insertLevel = std::min(m_Depth, ViewportMaxLevel);
+    const auto [node, offset] = GetCenteredNode(ViewportMaxLevel);
+    const auto* centered =
+        SetManyImpl(node, offset, cells, insertLevel, alive);
+    m_Root = SetCenteredNode(m_Root, m_Depth, centered, insertLevel);
+}
+
+const LifeNode* HashQuadtree::SetManyImpl(const LifeNode* node, Vec2L pos,
+                                          std::span<Vec2L> cells,
+                                          int32_t level, bool alive) const {
+    if (cells.empty() || (!alive && IsEmptyNode(node)))
+        return node;
+
+    if (level == 0)
+        return alive ? TrueNode : FalseNode;
+
+    const auto* source = (node == FalseNode) ? EmptyTree(level) : node;
+    const auto half = Pow2(level - 1);
+    const auto midY = pos.Y + half;
+    const auto midX = pos.X + half;
+
+    using std::ranges::partition;
+
+    const auto itY =
+        partition(cells, [midY](Vec2L v) { return v.Y < midY; }).begin();
+    const std::span<Vec2L> north{cells.begin(), itY};
+    const std::span<Vec2L> south{itY, cells.end()};
+
+    const auto itNorthX =
+        partition(north, [midX](Vec2L v) { return v.X < midX; }).begin();
+    const auto itSouthX =
+        partition(south, [midX](Vec2L v) { return v.X < midX; }).begin();
+
+    return FindOrCreate(
+        SetManyImpl(source->NorthWest, pos, {north.begin(), itNorthX},
+                    level - 1, alive),
+        SetManyImpl(source->NorthEast, {pos.X + half, pos.Y},
+                    {itNorthX, north.end()}, level - 1, alive),
+        SetManyImpl(source->SouthWest, {pos.X, pos.Y + half},
+                    {south.begin(), itSouthX}, level - 1, alive),
+        SetManyImpl(source->SouthEast, {pos.X + half, pos.Y + half},
+                    {itSouthX, south.end()}, level - 1, alive));
+}
+
 void HashQuadtree::Insert(const HashQuadtree& other, Vec2 offset) {
     if (other.m_Root == FalseNode || other.m_Root->IsEmpty) {
         return;
     }
+    // Nodes of `other` from another cache are copied in as they are used.
+    AdoptNodes();
 
     const auto sourceLevel = std::min(other.m_Depth, ViewportMaxLevel);
     const auto [sourceNode, sourceOffset] =
@@ -164,6 +585,7 @@ void HashQuadtree::Insert(const HashQuadtree& other, Vec2 offset) {
 
     if (centeredRoot == FalseNode || centeredRoot->IsEmpty) {
         m_Root = other.m_Root;
+        m_Arena = other.m_Arena;
         m_Depth = other.m_Depth;
         m_SeedOffset = other.m_SeedOffset + Vec2L{offset.X, offset.Y};
         return;
@@ -338,6 +760,7 @@ const LifeNode* HashQuadtree::SetImpl(const LifeNode* node, Vec2L pos,
 }
 
 void HashQuadtree::Clear(Rect region) {
+    AdoptNodes();
     const auto [node, offset] = GetCenteredNode(ViewportMaxLevel);
     const auto* centered =
         ClearImpl(node, offset, region, std::min(m_Depth, ViewportMaxLevel));
@@ -445,6 +868,86 @@ HashQuadtree HashQuadtree::Extract(Rect region) const {
     return result;
 }
 
+void HashQuadtree::Rotate90(bool clockwise) {
+    ApplyTransform(clockwise ? NodeTransform::RotateClockwise
+                             : NodeTransform::RotateCounterclockwise);
+}
+
+void HashQuadtree::Flip(bool vertical) {
+    ApplyTransform(vertical ? NodeTransform::FlipVertical
+                            : NodeTransform::FlipHorizontal);
+}
+
+void HashQuadtree::Transpose() { ApplyTransform(NodeTransform::Transpose); }
+
+void HashQuadtree::Translate(Vec2L offset) { m_SeedOffset += offset; }
+
+void HashQuadtree::ApplyTransform(NodeTransform transform) {
+    if (IsEmptyNode(m_Root))
+        return;
+    AdoptNodes();
+
+    // From level 1 up, the seed offset is the corner shared by the root's
+    // quadrants, which the transform moves like any other point.
+    ExpandUniverse(1);
+
+    TransformMemo memo{};
+    m_Root = TransformNode(m_Root, m_Depth, transform, memo);
+
+    const auto [x, y] = m_SeedOffset;
+    m_SeedOffset = [&] -> Vec2L {
+        switch (transform) {
+        case NodeTransform::RotateClockwise:
+            return {-y, x};
+        case NodeTransform::RotateCounterclockwise:
+            return {y, -x};
+        case NodeTransform::FlipHorizontal:
+            return {-x, y};
+        case NodeTransform::FlipVertical:
+            return {x, -y};
+        case NodeTransform::Transpose:
+            return {y, x};
+        }
+        std::unreachable();
+    }();
+}
+
+const LifeNode* HashQuadtree::TransformNode(const LifeNode* node,
+                                            int32_t level,
+                                            NodeTransform transform,
+                                            TransformMemo& memo) const {
+    // Single cells and empty nodes are symmetric.
+    if (level == 0 || IsEmptyNode(node))
+        return node;
+
+    if (const auto it = memo.find(node); it != memo.end())
+        return it->second;
+
+    const auto* nw = TransformNode(node->NorthWest, level - 1, transform, memo);
+    const auto* ne = TransformNode(node->NorthEast, level - 1, transform, memo);
+    const auto* sw = TransformNode(node->SouthWest, level - 1, transform, memo);
+    const auto* se = TransformNode(node->SouthEast, level - 1, transform, memo);
+
+    const auto* result = [&] {
+        switch (transform) {
+        case NodeTransform::RotateClockwise:
+            return FindOrCreate(sw, nw, se, ne);
+        case NodeTransform::RotateCounterclockwise:
+            return FindOrCreate(ne, se, nw, sw);
+        case NodeTransform::FlipHorizontal:
+            return FindOrCreate(ne, nw, se, sw);
+        case NodeTransform::FlipVertical:
+            return FindOrCreate(sw, se, nw, ne);
+        case NodeTransform::Transpose:
+            return FindOrCreate(nw, sw, ne, se);
+        }
+        std::unreachable();
+    }();
+
+    memo.emplace(node, result);
+    return result;
+}
+
 static int64_t FindExtentImpl(const LifeNode* node, Vec2L pos, int32_t level,
                               bool returnX, bool findLeast) {
     constexpr static auto hasLiveCells = [](const LifeNode* n) {
@@ -593,6 +1096,102 @@ bool HashQuadtree::GetImpl(const LifeNode* node, Vec2L pos, Vec2 targetPos,
     }
 }
 
+void HashQuadtree::RasterizeRegion(Rect bounds, int32_t level,
+                                   std::span<uint8_t> buffer) const {
+    if (m_Root == FalseNode || level < 0 || m_Depth > MaxNodeWalkDepth ||
+        bounds.Width <= 0 || bounds.Height <= 0) {
+        return;
+    }
+
+    const auto columns =
+        (static_cast<int64_t>(bounds.Width) + Pow2(level) - 1) >> level;
+    const RasterTarget target{buffer, bounds.Width, bounds.Height, level,
+                              static_cast<size_t>((columns + 7) / 8)};
+
+    const auto half = (m_Depth == 0 ? 0 : Pow2(m_Depth - 1));
+    RasterizeRegionImpl(target, m_Root,
+                        {m_SeedOffset.X - half - bounds.X,
+                         m_SeedOffset.Y - half - bounds.Y},
+                        m_Depth);
+}
+
+void HashQuadtree::RasterizeRegionImpl(const RasterTarget& target,
+                                       const LifeNode* node, Vec2L pos,
+                                       int32_t level) {
+    const auto size = Pow2(level);
+    if (node == FalseNode || node->IsEmpty || pos.X >= target.Width ||
+        pos.Y >= target.Height || pos.X + size <= 0 || pos.Y + size <= 0) {
+        return;
+    }
+
+    if (level == target.Level) {
+        // A node straddling the region's edge marks its first visible texel.
+        const auto x =
+            static_cast<size_t>(std::max<int64_t>(pos.X, 0) >> level);
+        const auto y =
+            static_cast<size_t>(std::max<int64_t>(pos.Y, 0) >> level);
+        target.Buffer[y * target.Stride + x / 8] |=
+            static_cast<uint8_t>(1U << (x % 8));
+        return;
+    }
+
+    if (level == 3 && target.Level == 0) {
+        const auto mask = BlockMask(node);
+        for (auto row = 0; row < 8; ++row) {
+            const auto y = pos.Y + row;
+            if (y < 0 || y >= target.Height) {
+                continue;
+            }
+
+            // Clip the row to the region, then shift it into place.
+            auto bits = static_cast<uint32_t>((mask >> (8 * row)) & 0xFFU);
+            auto x = pos.X;
+            if (x < 0) {
+                bits >>= -x;
+                x = 0;
+            }
+            if (target.Width - x < 8) {
+                bits &= (1U << (target.Width - x)) - 1U;
+            }
+            if (bits == 0) {
+                continue;
+            }
+
+            auto* destination = target.Buffer.data() +
+                                static_cast<size_t>(y) * target.Stride +
+                                static_cast<size_t>(x / 8);
+            for (bits <<= (x % 8); bits != 0; bits >>= 8U) {
+                *destination++ |= static_cast<uint8_t>(bits);
+            }
+        }
+        return;
+    }
+
+    const auto half = size / 2;
+    RasterizeRegionImpl(target, node->NorthWest, pos, level - 1);
+    RasterizeRegionImpl(target, node->NorthEast, {pos.X + half, pos.Y},
+                        level - 1);
+    RasterizeRegionImpl(target, node->SouthWest, {pos.X, pos.Y + half},
+                        level - 1);
+    RasterizeRegionImpl(target, node->SouthEast, {pos.X + half, pos.Y + half},
+                        level - 1);
+}
+
+uint64_t HashQuadtree::BlockMask(const LifeNode* node, int32_t level) {
+    if (node == FalseNode || node->IsEmpty) {
+        return 0;
+    }
+    if (level == 0) {
+        return 1;
+    }
+
+    const auto half = 1U << (level - 1);
+    return BlockMask(node->NorthWest, level - 1) |
+           BlockMask(node->NorthEast, level - 1) << half |
+           BlockMask(node->SouthWest, level - 1) << (8 * half) |
+           BlockMask(node->SouthEast, level - 1) << (8 * half + half);
+}
+
 int64_t HashQuadtree::CalculateTreeSize() const {
     if (m_Root == FalseNode) {
         return 0;
@@ -612,11 +1211,20 @@ BigInt HashQuadtree::PopulationOf(const LifeNode* node) const {
         return BigOne;
     }
 
+    if (node->Population != PopulationOverflow) {
+        return node->Population;
+    }
+
+    // Addresses of freed nodes may since have been reused.
+    if (const auto destroyed = LifeNodeArena::DestroyedCount();
+        destroyed != s_PopulationArenas) {
+        s_PopulationCache.clear();
+        s_PopulationArenas = destroyed;
+    }
     if (auto it = s_PopulationCache.find(node); it != s_PopulationCache.end()) {
         return it->second;
     }
 
-    // 4. Insert and return a copy
     return s_PopulationCache[node] =
                PopulationOf(node->NorthWest) + PopulationOf(node->NorthEast) +
                PopulationOf(node->SouthWest) + PopulationOf(node->SouthEast);
@@ -715,10 +1323,7 @@ const LifeNode* HashQuadtree::SetCenteredNode(const LifeNode* outer,
     return FindOrCreate(nw, ne, sw, se);
 }
 
-const BigInt& HashQuadtree::Population() const {
-    [[maybe_unused]] auto x = PopulationOf(m_Root);
-    return s_PopulationCache[m_Root];
-}
+BigInt HashQuadtree::Population() const { return PopulationOf(m_Root); }
 
 HashQuadtree::Iterator HashQuadtree::begin() const {
     if (m_Root == FalseNode) {
@@ -745,36 +1350,157 @@ const LifeNode* HashQuadtree::FindOrCreate(const LifeNode* nw,
                                            const LifeNode* ne,
                                            const LifeNode* sw,
                                            const LifeNode* se) const {
+    auto& cache = ActiveCache();
     LifeNodeKey key{nw, ne, sw, se};
-    if (const auto itr = s_Cache[s_CacheIndex].NodeMap.find(key);
-        itr != s_Cache[s_CacheIndex].NodeMap.end()) {
-        return itr->first;
+    {
+        const auto lock = ReadLock(cache);
+        if (const auto itr = cache.NodeSet.find(key);
+            itr != cache.NodeSet.end()) {
+            return *itr;
+        }
+    }
+
+    // Nodes only ever point into their own arena, so that releasing another
+    // cache cannot leave them dangling. Children from elsewhere are copied in
+    // first, which is the only way their lookup above can miss for them.
+    if (const auto arena = cache.NodeStorage->Id();
+        IsForeign(nw, arena) || IsForeign(ne, arena) || IsForeign(sw, arena) ||
+        IsForeign(se, arena)) {
+        ImportMemo memo{};
+        return FindOrCreate(ImportNode(nw, memo), ImportNode(ne, memo),
+                            ImportNode(sw, memo), ImportNode(se, memo));
+    }
+
+    const auto lock = WriteLock(cache);
+    if (lock.owns_lock()) {
+        // Another thread may have created the node since the lookup.
+        if (const auto itr = cache.NodeSet.find(key);
+            itr != cache.NodeSet.end()) {
+            return *itr;
+        }
     }
 
-    auto* node = s_Cache[s_CacheIndex].NodeStorage.emplace(nw, ne, sw, se);
-    s_Cache[s_CacheIndex].NodeMap[node] = nullptr;
+    auto* node = cache.NodeStorage->emplace(nw, ne, sw, se);
+    cache.NodeSet.insert(node);
     return node;
 }
 
 std::optional<const LifeNode*> HashQuadtree::Find(const LifeNode* node) const {
-    auto it = s_Cache[s_CacheIndex].NodeMap.find(node);
-    if (it == s_Cache[s_CacheIndex].NodeMap.end() || it->second == nullptr) {
-        return std::nullopt;
+    const auto& results = ActiveResults().FastResults;
+    const auto lock = ReadLock(ActiveCache());
+    if (const auto it = results.find(node); it != results.end()) {
+        return it->second;
     }
-    return it->second;
+    return std::nullopt;
 }
 
 void HashQuadtree::CacheResult(const LifeNode* key,
                                const LifeNode* value) const {
-    s_Cache[s_CacheIndex].NodeMap[key] = value;
+    auto& results = ActiveResults().FastResults;
+    const auto lock = WriteLock(ActiveCache());
+    if (results.size() >= RuleResultCache::MaxResultCount) {
+        results.clear();
+    }
+    results[key] = value;
 }
 
-void HashQuadtree::ClearCache() {
-    s_Cache[s_CacheIndex].NodeMap.clear();
+std::optional<const LifeNode*> HashQuadtree::FindSlow(SlowKey key,
+                                                      int32_t phase) const {
+    auto& results = ActiveResults().SlowResults[phase];
+    // Lookups update the clock, so even they need exclusive access.
+    const auto lock = WriteLock(ActiveCache());
+    return results.Find(key);
+}
+
+void HashQuadtree::CacheSlowResult(SlowKey key, int32_t phase,
+                                   const LifeNode* value) const {
+    auto& results = ActiveResults().SlowResults[phase];
+    const auto lock = WriteLock(ActiveCache());
+    results.Insert(key, value);
+}
+
+bool HashQuadtree::SetSlowCacheBudget(size_t bytes) {
+    auto& cache = ActiveCache();
+    // Held throughout, so that no one else starts sharing the cache.
+    std::scoped_lock cachesLock{s_CacheMutex};
+    if (!IsSoleUser(cache)) {
+        return false;
+    }
+
+    const auto lock = WriteLock(cache);
+    cache.SlowCacheCapacity = bytes / RuleResultCache::SlowEntryBytes;
+    for (auto& [fingerprint, results] : cache.RuleResults) {
+        for (auto& slowResults : results->SlowResults)
+            slowResults.SetCapacity(cache.SlowCacheCapacity);
+    }
+    return true;
+}
+
+CacheStats HashQuadtree::SlowCacheStats() {
+    const auto& results = ActiveResults();
+    const auto lock = ReadLock(ActiveCache());
+    CacheStats stats{};
+    for (const auto& slowResults : results.SlowResults)
+        stats += slowResults.Stats();
+    return stats;
+}
+
+size_t HashQuadtree::CreatedNodeCount() {
+    auto& cache = ActiveCache();
+    const auto lock = ReadLock(cache);
+    return cache.NodeStorage->size();
+}
+
+size_t HashQuadtree::CacheMemoryUsage() {
+    // ankerl's maps keep their entries in a vector, indexed by 8-byte buckets.
+    constexpr auto bucketBytes = 8UZ;
+    const auto tableBytes = [&](const auto& table) {
+        using Entry = typename std::decay_t<decltype(table)>::value_type;
+        return table.values().capacity() * sizeof(Entry) +
+               table.bucket_count() * bucketBytes;
+    };
+
+    auto& cache = ActiveCache();
+    const auto lock = ReadLock(cache);
+    auto bytes =
+        cache.NodeStorage->AllocatedBytes() + tableBytes(cache.NodeSet);
+    for (const auto& [fingerprint, results] : cache.RuleResults) {
+        bytes += tableBytes(results->FastResults);
+        for (const auto& slowResults : results->SlowResults)
+            bytes += slowResults.size() * RuleResultCache::SlowEntryBytes;
+    }
+    return bytes;
+}
+
+bool HashQuadtree::ClearCache() {
+    auto& cache = ActiveCache();
+    std::scoped_lock cachesLock{s_CacheMutex};
+    // Another thread still interning nodes would create duplicates of the
+    // ones forgotten here, breaking comparisons by pointer.
+    if (!IsSoleUser(cache) ||
+        cache.Concurrent.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    const auto lock = WriteLock(cache);
+    cache.NodeSet.clear();
+    cache.RuleResults.clear();
+    // Empty nodes no longer in NodeSet would otherwise have duplicates.
+    cache.EmptyNodeCache.clear();
+    s_ActiveResults = nullptr;
     s_PopulationCache.clear();
+    return true;
+}
+
+bool HashQuadtree::IsSoleUser(const HashLifeCache& cache) {
+    return !cache.Shared || s_SharedCacheUsers <= 1;
 }
 
 void HashQuadtree::ExpandUniverse(int32_t targetLevel) {
+    if (m_Depth >= targetLevel)
+        return;
+
+    AdoptNodes();
     while (m_Depth < targetLevel) {
         m_Root = ExpandNode(m_Root, m_Depth);
         m_Depth++;
@@ -803,16 +1529,24 @@ const LifeNode* HashQuadtree::EmptyTree(int32_t level) const {
         return FalseNode;
     }
 
-    if (level >=
-        static_cast<int32_t>(s_Cache[s_CacheIndex].EmptyNodeCache.size())) {
-        s_Cache[s_CacheIndex].EmptyNodeCache.resize(level + 1, nullptr);
-    } else if (s_Cache[s_CacheIndex].EmptyNodeCache[level] != nullptr) {
-        return s_Cache[s_CacheIndex].EmptyNodeCache[level];
+    auto& cache = ActiveCache();
+    auto& emptyNodes = cache.EmptyNodeCache;
+    {
+        const auto lock = ReadLock(cache);
+        if (level < static_cast<int32_t>(emptyNodes.size()) &&
+            emptyNodes[level] != nullptr) {
+            return emptyNodes[level];
+        }
     }
 
     const auto* child = EmptyTree(level - 1);
     const auto* result = FindOrCreate(child, child, child, child);
-    s_Cache[s_CacheIndex].EmptyNodeCache[level] = result;
+
+    const auto lock = WriteLock(cache);
+    if (level >= static_cast<int32_t>(emptyNodes.size())) {
+        emptyNodes.resize(level + 1, nullptr);
+    }
+    emptyNodes[level] = result;
     return result;
 }
 
@@ -851,6 +1585,7 @@ const LifeNode* HashQuadtree::BuildTreeRegion(std::span<Vec2L> cells, Vec2L pos,
 }
 
 const LifeNode* HashQuadtree::BuildTree(std::span<const Vec2> cells) {
+    GOL_TRACE_ZONE("HashQuadtree::BuildTree");
     if (cells.empty()) {
         m_SeedOffset = {0, 0};
         return FalseNode;
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <ankerl/unordered_dense.h>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "LargerThanLife.hpp"
+#include "LifeHashSet.hpp"
+#include "Plane.hpp"
+
+namespace gol {
+std::string_view LargerThanLife::Identifier = "LargerThanLife";
+
+LargerThanLife::LargerThanLife(const LargerThanLifeRule& rule)
+    : LargerThanLife(rule,
+                     std::make_unique<Plane>(rule.Bounds().value_or(Rect{}))) {}
+
+LargerThanLife::LargerThanLife(const LargerThanLifeRule& rule,
+                               std::unique_ptr<Topology> topology)
+    : m_Rule(rule), m_Topology(std::move(topology)) {}
+
+void LargerThanLife::SetTopology(std::unique_ptr<Topology> topology) {
+    m_Topology = std::move(topology);
+}
+
+void LargerThanLife::SetRule(const LifeRule&) {
+    assert(false && "LifeRules must be stepped by HashLife; see GameGrid");
+}
+
+void LargerThanLife::SetRule(const LargerThanLifeRule& rule) {
+    m_Rule = rule;
+    if (rule.Bounds()) {
+        m_Topology = std::make_unique<Plane>(*rule.Bounds());
+    }
+}
+
+bool LargerThanLife::CompatibleWith(const LifeDataStructure& data) const {
+    return typeid(HashQuadtree) == typeid(data);
+}
+
+std::string_view LargerThanLife::GetIdentifier() const { return Identifier; }
+
+std::unique_ptr<LifeAlgorithm> LargerThanLife::Clone() const {
+    return std::make_unique<LargerThanLife>(m_Rule, m_Topology->Clone());
+}
+
+BigInt LargerThanLife::Step(LifeDataStructure& data, const BigInt& numSteps,
+                            std::stop_token stopToken) {
+    auto& hashQuadtree = dynamic_cast<HashQuadtree&>(data);
+    const auto targetSteps = numSteps.is_zero() ? BigOne : numSteps;
+
+    BigInt generation{};
+    while (generation < targetSteps) {
+        if (stopToken.stop_requested())
+            return generation;
+
+        AdvanceGeneration(hashQuadtree);
+        m_Topology->CleanupBorderCells(hashQuadtree);
+        ++generation;
+    }
+
+    return generation;
+}
+
+void LargerThanLife::AdvanceGeneration(HashQuadtree& data) const {
+    if (data.empty())
+        return;
+
+    // Tiles are at least as wide as the range, so every neighborhood that
+    // reaches into a tile lies within it and its eight neighbors.
+    const auto range = m_Rule.Range();
+    const auto tileSize = std::max(MinTileSize, range);
+    const auto tileOf = [tileSize](Vec2 cell) {
+        const auto floorDiv = [tileSize](int64_t value) {
+            return static_cast<int32_t>(
+                (value >= 0 ? value : value - tileSize + 1) / tileSize);
+        };
+        return Vec2{floorDiv(cell.X), floorDiv(cell.Y)};
+    };
+
+    ankerl::unordered_dense::map<Vec2, std::vector<Vec2>> tiles{};
+    for (const auto cell : data)
+        tiles[tileOf(cell)].push_back(cell);
+
+    // Only cells within `range` of a live cell can possibly change, so tiles
+    // away from every live one are never visited.
+    LifeHashSet candidates{};
+    for (const auto& [tile, cells] : tiles) {
+        for (auto dy = -1; dy <= 1; ++dy)
+            for (auto dx = -1; dx <= 1; ++dx)
+                candidates.insert(tile + Vec2{dx, dy});
+    }
+
+    // Each tile gets its own summed-area table, covering the tile and an
+    // apron of `range` cells around it. It has a leading row and column of
+    // zeroes, so that sums[y][x] holds the number of live cells above and to
+    // the left of the window coordinate (x, y).
+    const auto side = static_cast<int64_t>(tileSize) + 2 * range;
+    const auto stride = static_cast<size_t>(side) + 1;
+    std::vector<int32_t> sums(stride * stride);
+    const auto index = [stride](int64_t x, int64_t y) {
+        return static_cast<size_t>(y) * stride + static_cast<size_t>(x);
+    };
+    const auto countCells = [&](int64_t left, int64_t top, int64_t right,
+                                int64_t bottom) {
+        return sums[index(right, bottom)] - sums[index(left, bottom)] -
+               sums[index(right, top)] + sums[index(left, top)];
+    };
+
+    std::vector<Vec2> nextGeneration{};
+    for (const auto tile : candidates) {
+        const auto windowX = static_cast<int64_t>(tile.X) * tileSize - range;
+        const auto windowY = static_cast<int64_t>(tile.Y) * tileSize - range;
+
+        std::ranges::fill(sums, 0);
+        auto population = 0UZ;
+        for (auto dy = -1; dy <= 1; ++dy) {
+            for (auto dx = -1; dx <= 1; ++dx) {
+                const auto neighbor = tiles.find(tile + Vec2{dx, dy});
+                if (neighbor == tiles.end())
+                    continue;
+                for (const auto cell : neighbor->second) {
+                    const auto x = cell.X - windowX;
+                    const auto y = cell.Y - windowY;
+                    if (x < 0 || y < 0 || x >= side || y >= side)
+                        continue;
+                    sums[index(x + 1, y + 1)] = 1;
+                    ++population;
+                }
+            }
+        }
+        // Birth on zero neighbors is not supported, so nothing can happen
+        // here.
+        if (population == 0)
+            continue;
+
+        for (auto y = 1; y <= side; ++y) {
+            for (auto x = 1; x <= side; ++x) {
+                sums[index(x, y)] += sums[index(x, y - 1)] +
+                                     sums[index(x - 1, y)] -
+                                     sums[index(x - 1, y - 1)];
+            }
+        }
+
+        // Cells of the tile sit `range` cells into the window.
+        for (auto y = 0; y < tileSize; ++y) {
+            const auto cellY = windowY + range + y;
+            if (cellY < std::numeric_limits<int32_t>::min() ||
+                cellY > std::numeric_limits<int32_t>::max())
+                continue;
+            for (auto x = 0; x < tileSize; ++x) {
+                const auto cellX = windowX + range + x;
+                if (cellX < std::numeric_limits<int32_t>::min() ||
+                    cellX > std::numeric_limits<int32_t>::max())
+                    continue;
+
+                const bool alive =
+                    countCells(x + range, y + range, x + range + 1,
+                               y + range + 1) != 0;
+                auto count = countCells(x, y, x + 2 * range + 1,
+                                        y + 2 * range + 1);
+                if (!m_Rule.CountsMiddle() && alive)
+                    --count;
+
+                if (alive ? m_Rule.Survives(count) : m_Rule.IsBorn(count))
+                    nextGeneration.emplace_back(static_cast<int32_t>(cellX),
+                                                static_cast<int32_t>(cellY));
+            }
+        }
+    }
+
+    data = HashQuadtree{nextGeneration};
+}
+} // namespace gol
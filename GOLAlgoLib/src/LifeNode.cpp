@@ -1,10 +1,14 @@
 #include "LifeNode.hpp"
+#include <atomic>
 #include <bit>
 #include <functional>
 
 namespace gol {
 
 namespace {
+std::atomic<uint64_t> s_DestroyedArenas{};
+std::atomic<uint32_t> s_NextArenaId{1};
+
 // Directly encodes a level-1 quadrant's cells into the known bit positions
 // for each 2x2 sub-quadrant of the 4x4 grid.
 uint16_t EncodeQuadrantNW(const LifeNode* q) {
@@ -221,10 +225,38 @@ size_t LifeNodeHash::operator()(const LifeNodeKey& key) const {
     return static_cast<size_t>(key.Hash);
 }
 
+LifeNodeArena::LifeNodeArena() {
+    // Skips 0, which marks TrueNode, should the ids ever wrap around.
+    do {
+        m_Id = s_NextArenaId.fetch_add(1, std::memory_order_relaxed);
+    } while (m_Id == 0);
+}
+
+LifeNodeArena::~LifeNodeArena() {
+    if (!m_Blocks.empty()) {
+        s_DestroyedArenas.fetch_add(1, std::memory_order_release);
+    }
+}
+
+uint64_t LifeNodeArena::DestroyedCount() {
+    return s_DestroyedArenas.load(std::memory_order_acquire);
+}
+
 LifeNode* LifeNodeArena::last() const {
     return m_Blocks.back().get() + (m_Current - 1);
 }
 
+size_t LifeNodeArena::size() const {
+    if (m_Blocks.empty()) {
+        return 0;
+    }
+    return (m_Blocks.size() - 1) * BlockCapacity + m_Current;
+}
+
+size_t LifeNodeArena::AllocatedBytes() const {
+    return m_Blocks.size() * BlockCapacity * sizeof(LifeNode);
+}
+
 void LifeNodeArena::clear() {
     m_Blocks.clear();
     m_Current = BlockCapacity;
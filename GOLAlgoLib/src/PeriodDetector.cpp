@@ -0,0 +1,30 @@
+#include <optional>
+
+#include "PeriodDetector.hpp"
+
+namespace gol {
+
+std::optional<PeriodInfo>
+PeriodDetector::Observe(const HashQuadtree& tree, const BigInt& generation) {
+    const auto core = tree.Core();
+    if (!core)
+        return std::nullopt;
+
+    const auto [entry, inserted] = m_Observations.try_emplace(
+        core->Node, Observation{generation, core->Position});
+    if (inserted)
+        return std::nullopt;
+
+    const auto& first = entry->second;
+    if (generation <= first.Generation)
+        return std::nullopt;
+
+    return PeriodInfo{
+        .Start = first.Generation,
+        .Period = generation - first.Generation,
+        .Displacement = core->Position - first.Position,
+    };
+}
+
+void PeriodDetector::Clear() { m_Observations.clear(); }
+} // namespace gol
@@ -1,5 +1,6 @@
 #include "Torus.hpp"
 #include "HashQuadtree.hpp"
+#include "Tracing.hpp"
 
 namespace gol {
 Torus::Torus(Rect bounds) : Topology(bounds) {}
@@ -27,6 +28,7 @@ int32_t Torus::Log2MaxIncrement(const BigInt& requestedStep) const {
 }
 
 void Torus::PrepareBorderCells(LifeDataStructure& data) {
+    GOL_TRACE_ZONE("Torus::PrepareBorderCells");
     auto bounds = GetBounds();
     if (!bounds) {
         return;
@@ -0,0 +1,54 @@
+#ifndef AdaptiveStepController_hpp_
+#define AdaptiveStepController_hpp_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "BigInt.hpp"
+
+namespace gol {
+// Chooses the step count of a running simulation in auto step mode. Steps are
+// powers of two, so HashLife covers each one with a single jump, and the
+// exponent is grown or shrunk after every update so that updates take about
+// one frame budget.
+class AdaptiveStepController {
+  public:
+    constexpr static auto DefaultTarget = std::chrono::milliseconds{16};
+    constexpr static int32_t MaxLog2Step = 1024;
+
+    // Cache growth over a single update that counts as a spike: a quarter of
+    // the cache, but never less than this many bytes.
+    constexpr static size_t MinSpikeBytes = 64UZ << 20;
+
+    // Fast updates needed before growing again after a back off.
+    constexpr static int32_t GrowCooldown = 8;
+
+    explicit AdaptiveStepController(
+        std::chrono::duration<double> target = DefaultTarget);
+
+    // Starts over from single generation steps.
+    void Reset();
+
+    const BigInt& StepCount() const { return m_StepCount; }
+    int32_t Log2StepCount() const { return m_Log2Step; }
+
+    // Adjusts the step size after an update that took `elapsed` and grew the
+    // cache from `cacheBytesBefore` to `cacheBytesAfter`.
+    void Record(std::chrono::duration<double> elapsed, size_t cacheBytesBefore,
+                size_t cacheBytesAfter);
+
+  private:
+    void SetLog2Step(int32_t log2Step);
+    void Shrink(int32_t levels);
+
+  private:
+    std::chrono::duration<double> m_Target;
+    int32_t m_Log2Step = 0;
+    // Kept alongside the exponent so that reading it never allocates.
+    BigInt m_StepCount = 1;
+    int32_t m_Cooldown = 0;
+};
+} // namespace gol
+
+#endif
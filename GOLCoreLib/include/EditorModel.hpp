@@ -10,13 +10,16 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <stop_token>
 #include <string>
 
 #include "FileFormatHandler.hpp"
 #include "GameEnums.hpp"
 #include "GameGrid.hpp"
+#include "GenerationTimeline.hpp"
 #include "Graphics2D.hpp"
+#include "HashQuadtree.hpp"
 #include "SelectionManager.hpp"
 #include "SimulationCommand.hpp"
 #include "SimulationSettings.hpp"
@@ -74,7 +77,8 @@ struct ExecuteCommandResult {
 
 class EditorModel {
   public:
-    EditorModel(uint32_t id, const std::filesystem::path& path, Size2 gridSize);
+    EditorModel(uint32_t id, const std::filesystem::path& path, Size2 gridSize,
+                bool shareNodes = false);
 
     // Simulation lifecycle
     SimulationState StartSimulation();
@@ -90,6 +94,18 @@ class EditorModel {
     // Apply per-frame settings from the control panel
     void ApplySettings(const SimulationSettings& settings);
 
+    // Whether this is the editor the user is working in, whose simulation
+    // runs ahead of the others
+    void SetFocused(bool focused);
+
+    // While paused, keeps the worker computing the next few steps so that
+    // stepping is instant (call once per frame)
+    void SpeculateSteps();
+
+    // Adds the current generation to the timeline when it is due a
+    // checkpoint (call once per frame)
+    void RecordTimeline();
+
     // Command handlers
     SimulationState HandleStart();
     SimulationState HandleClear();
@@ -98,6 +114,7 @@ class EditorModel {
     SimulationState HandlePause();
     SimulationState HandleResume();
     SimulationState HandleStep();
+    SimulationState HandleRewind(const BigInt& generation);
     SimulationState HandleRuleChange(std::string_view ruleStr);
     SimulationState HandleUndo();
     SimulationState HandleRedo();
@@ -123,7 +140,9 @@ class EditorModel {
     bool UpdateSelectionAreaTracked(Vec2 gridPos);
     void TryResetSelection();
     void BeginPaintChange();
-    void PaintCell(Vec2 pos, bool value);
+    // Sets the in-bounds cells of `positions` that do not already hold
+    // `value`, folding them into the current paint change.
+    void PaintCells(std::span<const Vec2> positions, bool value);
     void MarkSaved();
 
     // Facade read API for SimulationEditor.
@@ -152,7 +171,7 @@ class EditorModel {
     const HashQuadtree& SelectionGridData() const {
         return m_SelectionManager.GridData();
     }
-    const BigInt& SelectedPopulation() const {
+    BigInt SelectedPopulation() const {
         return m_SelectionManager.SelectedPopulation();
     }
     std::optional<Rect> SelectionBoundsOpt() const {
@@ -181,6 +200,7 @@ class EditorModel {
     void SetState(SimulationState state) { m_State = state; }
 
     uint32_t EditorID() const { return m_EditorID; }
+    size_t CacheIndex() const { return m_Cache.Index(); }
     bool IsSaved() const { return m_VersionManager.IsSaved(); }
 
     const std::filesystem::path& CurrentFilePath() const {
@@ -204,10 +224,15 @@ class EditorModel {
     void TryPushVersionChange(const std::optional<VersionState>& change);
     void TryPushVersionChange(const VersionState& change);
 
+    // Declared first so that the cache outlives every thread using it.
+    HashLifeCacheLease m_Cache;
+
     SelectionManager m_SelectionManager;
 
     GameGrid m_Grid;
     GameGrid m_InitialGrid;
+    // Checkpoints of the run started from m_InitialGrid.
+    GenerationTimeline m_Timeline;
 
     VersionManager m_VersionManager;
 
@@ -11,6 +11,7 @@
 #include "Graphics2D.hpp"
 #include "PopupWindow.hpp"
 #include "PresetSelection.hpp"
+#include "ProfilerPanel.hpp"
 #include "SimulationCommand.hpp"
 #include "SimulationControl.hpp"
 #include "SimulationEditor.hpp"
@@ -98,6 +99,7 @@ class Game {
 
     SimulationControl m_Control;
     PresetSelection m_PresetSelection;
+    ProfilerPanel m_Profiler;
     ImFont* m_Font = nullptr; // Standard font for all children
     float m_FontSize = 30.0f; // Scaled font size based on screen
 
@@ -0,0 +1,18 @@
+#ifndef ProfilerPanel_hpp_
+#define ProfilerPanel_hpp_
+
+#include "Profiler.hpp"
+
+namespace gol {
+// Shows the rolling history of every profiler metric, so that a slowdown can
+// be traced to drawing, uploading, stepping or cache growth while it happens.
+class ProfilerPanel {
+  public:
+    void Update();
+
+  private:
+    static void DisplayMetric(ProfileMetric metric);
+};
+} // namespace gol
+
+#endif
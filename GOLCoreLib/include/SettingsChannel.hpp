@@ -0,0 +1,54 @@
+#ifndef SettingsChannel_hpp_
+#define SettingsChannel_hpp_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace gol {
+// Hands settings from one writer thread to one reader thread without locks.
+// Both sides own a slot of a triple buffer: the writer swaps its slot into the
+// middle when it publishes, and the reader swaps the middle for its own slot
+// only when something new was published. Neither side waits on the other,
+// and a slot is never written while the reader holds it, so what Read returns
+// stays valid until the next Read.
+template <typename T>
+class SettingsChannel {
+  public:
+    // The writer's copy of the settings, which the reader sees once it is
+    // published.
+    const T& Current() const { return m_Current; }
+    T& Edit() { return m_Current; }
+
+    // Makes the writer's copy the latest settings. Only the writer may call
+    // this.
+    void Publish() {
+        m_Slots[m_WriteIndex] = m_Current;
+        m_WriteIndex = m_Middle.exchange(m_WriteIndex | FreshBit,
+                                         std::memory_order_acq_rel) &
+                       ~FreshBit;
+    }
+
+    // Returns the latest published settings. Only the reader may call this.
+    const T& Read() {
+        if (m_Middle.load(std::memory_order_relaxed) & FreshBit) {
+            m_ReadIndex =
+                m_Middle.exchange(m_ReadIndex, std::memory_order_acq_rel) &
+                ~FreshBit;
+        }
+        return m_Slots[m_ReadIndex];
+    }
+
+  private:
+    // Set on the middle index when it holds settings the reader has not seen.
+    constexpr static size_t FreshBit = 4UZ;
+
+    std::array<T, 3> m_Slots{};
+    T m_Current{};
+    size_t m_WriteIndex = 0UZ;
+    size_t m_ReadIndex = 1UZ;
+    std::atomic<size_t> m_Middle = 2UZ;
+};
+} // namespace gol
+
+#endif
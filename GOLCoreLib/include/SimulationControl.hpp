@@ -21,6 +21,7 @@
 #include "SelectionBoundsWidget.hpp"
 #include "SimulationControlResult.hpp"
 #include "StepWidget.hpp"
+#include "TimelineWidget.hpp"
 #include "WidgetResult.hpp"
 
 namespace gol {
@@ -62,6 +63,7 @@ class SimulationControl {
     StepWidget m_StepWidget;
     RuleWidget m_RuleWidget;
     DelayWidget m_DelayWidget;
+    TimelineWidget m_TimelineWidget;
     NoiseWidget m_NoiseWidget;
     SelectionBoundsWidget m_SelectionBoundsWidget;
     CameraPositionWidget m_CameraPositionWidget;
@@ -80,6 +82,7 @@ void SimulationControl::ForEachWidget(auto&& widgetFunc) {
     widgetFunc(m_CameraPositionWidget);
     widgetFunc(m_RuleWidget);
     widgetFunc(m_StepWidget);
+    widgetFunc(m_TimelineWidget);
     widgetFunc(m_DelayWidget);
     widgetFunc(m_NoiseWidget);
 }
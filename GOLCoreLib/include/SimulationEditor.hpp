@@ -26,7 +26,8 @@ class SimulationEditor {
 
   public:
     SimulationEditor(uint32_t id, const std::filesystem::path& path,
-                     Size2 windowSize, Size2 gridSize);
+                     Size2 windowSize, Size2 gridSize,
+                     bool shareNodes = false);
 
     Rect WindowBounds() const;
     Rect ViewportBounds() const;
@@ -39,6 +40,7 @@ class SimulationEditor {
                         const PresetSelectionResult& presetArgs);
 
     uint32_t EditorID() const { return m_Model.EditorID(); }
+    void SetFocused(bool focused) { m_Model.SetFocused(focused); }
     bool IsSaved() const { return m_Model.IsSaved(); }
     bool operator==(const SimulationEditor& other) const;
 
@@ -105,12 +107,6 @@ class SimulationEditor {
 
     bool m_TakeKeyboardInput = false;
     bool m_TakeMouseInput = false;
-
-#ifdef _DEBUG
-    double lastTime = 0;
-    int32_t fps = 0;
-    int32_t frameCounter = 0;
-#endif
 };
 } // namespace gol
 
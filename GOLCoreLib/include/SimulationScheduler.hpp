@@ -0,0 +1,93 @@
+#ifndef SimulationScheduler_hpp_
+#define SimulationScheduler_hpp_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "GameEnums.hpp"
+
+namespace gol {
+class SimulationWorker;
+
+// Runs the steps of every running SimulationWorker on one pool of threads,
+// sized to the machine rather than to the number of open editors. The
+// focused editor is always served first, and the others according to the
+// BackgroundPolicy.
+class SimulationScheduler {
+  public:
+    // How long a throttled background worker waits between steps.
+    constexpr static auto ThrottleInterval = std::chrono::milliseconds{100};
+
+    static SimulationScheduler& Get();
+
+    explicit SimulationScheduler(size_t threadCount);
+    ~SimulationScheduler();
+
+    SimulationScheduler(const SimulationScheduler&) = delete;
+    auto& operator=(const SimulationScheduler&) = delete;
+
+    enum class TaskPriority {
+        Normal,
+        // Only runs while no normal step is ready, whatever editor it is for.
+        Idle
+    };
+
+    // Queues the next step of `worker` to run no earlier than `readyAt`.
+    // Later steps of the worker keep the same priority.
+    void Schedule(SimulationWorker& worker,
+                  std::chrono::steady_clock::time_point readyAt,
+                  TaskPriority priority = TaskPriority::Normal);
+
+    // Removes `worker` from the queue, waiting for any of its steps in
+    // progress to finish.
+    void Cancel(SimulationWorker& worker);
+
+    void SetBackgroundPolicy(BackgroundPolicy policy);
+
+    // Wakes the pool after a worker gains or loses focus.
+    void FocusChanged();
+
+  private:
+    struct Task {
+        SimulationWorker* Worker;
+        std::chrono::steady_clock::time_point ReadyAt;
+        // When the worker was queued, which throttling counts from.
+        std::chrono::steady_clock::time_point ScheduledAt;
+        TaskPriority Priority;
+    };
+
+    void ThreadLoop(std::stop_token stopToken);
+
+    // Removes and returns the task to run next. When none is ready, sets
+    // `wakeAt` to when one will be, if any. m_Mutex must be held.
+    std::optional<Task>
+    NextTask(std::optional<std::chrono::steady_clock::time_point>& wakeAt);
+
+    // When `task` may run under the background policy, or nothing while it
+    // is paused.
+    std::optional<std::chrono::steady_clock::time_point>
+    EffectiveReadyAt(const Task& task) const;
+
+    std::mutex m_Mutex;
+    std::condition_variable_any m_Condition;
+    std::vector<Task> m_Queue;
+    // Workers whose steps are in progress, so that Cancel can wait on them.
+    std::vector<SimulationWorker*> m_Running;
+    // Workers being cancelled, which must not be queued again.
+    std::vector<SimulationWorker*> m_Cancelling;
+    BackgroundPolicy m_Policy = BackgroundPolicy::Throttle;
+    // Bumped whenever a waiting thread may have something new to run.
+    uint64_t m_Changes = 0;
+
+    std::vector<std::jthread> m_Threads;
+};
+} // namespace gol
+
+#endif
@@ -3,23 +3,32 @@
 
 #include <array>
 #include <atomic>
-#include <condition_variable>
+#include <chrono>
 #include <cstdint>
-#include <memory>
+#include <deque>
+#include <functional>
 #include <mutex>
-#include <semaphore>
-#include <thread>
+#include <optional>
+#include <stop_token>
+#include <string>
 
+#include "AdaptiveStepController.hpp"
 #include "BigInt.hpp"
 #include "GameGrid.hpp"
 #include "HashQuadtree.hpp"
+#include "SettingsChannel.hpp"
 
 namespace gol {
+// Runs one editor's simulation in the background. Each step is a task on the
+// SimulationScheduler, so workers hold no thread of their own.
 class SimulationWorker {
   public:
     SimulationWorker(size_t cacheIndex);
     ~SimulationWorker();
 
+    SimulationWorker(const SimulationWorker&) = delete;
+    auto& operator=(const SimulationWorker&) = delete;
+
     void Start(GameGrid& initialGrid, bool oneStep = false,
                const std::function<void()>& onStop = {});
 
@@ -27,47 +36,96 @@ class SimulationWorker {
 
     bool IsRunning();
 
+    // Settings are published to the steps without locking, so they must all
+    // be changed from the same thread.
     void SetStepCount(const BigInt& stepCount);
+    // In auto step mode, runs pick their own power-of-two step counts to fill
+    // the frame budget. Single steps still use the set step count.
+    void SetAutoStep(bool autoStep);
     void SetTickDelayMs(int64_t tickDelayMs);
 
     const GameGrid* GetResult() const;
     std::chrono::duration<float> GetTimeSinceLastUpdate() const;
 
-    void BufferRule(std::unique_ptr<LifeRule> rule);
+    void BufferRule(std::string_view ruleString);
+
+    // While paused, precomputes the next few single steps from `grid` at the
+    // current step count, so that stepping can return at once. Does nothing
+    // if it is already speculating from `grid`; otherwise starts over.
+    void Speculate(const GameGrid& grid);
+
+    // Returns the result of stepping `grid` once, if it has already been
+    // speculated. Speculation then carries on from the returned grid.
+    std::optional<GameGrid> TakeSpeculated(const GameGrid& grid);
+
+    void StopSpeculating();
+
+    // Whether this worker belongs to the focused editor, which the scheduler
+    // serves first.
+    bool IsFocused() const;
+    void SetFocused(bool focused);
 
   private:
-    void ThreadLoop(std::stop_token threadStopToken);
+    friend class SimulationScheduler;
+
+    // Advances the worker buffer once and publishes it. Returns when the next
+    // step is due, or nothing once the run is over.
+    std::optional<std::chrono::steady_clock::time_point> Step();
 
-    size_t SimulationLoop(std::stop_token runStopToken);
+    // Adds one step to the speculated queue. Once it is full, the worker
+    // leaves the scheduler until TakeSpeculated wakes it.
+    std::optional<std::chrono::steady_clock::time_point> SpeculateStep();
+
+    // Stops the current run, waiting for a step in progress to finish.
+    void Halt();
 
   private:
     size_t m_CacheIndex;
 
-    std::mutex m_StepCountMutex;
-    BigInt m_StepCount = 1;
+    struct Settings {
+        BigInt StepCount = 1;
+        int64_t TickDelayMs = 0;
+        bool AutoStep = false;
+        std::string Rule;
+        // Bumped by BufferRule, so that each rule change is applied once.
+        uint64_t RuleVersion = 0;
+    };
 
-    std::unique_ptr<LifeRule> m_BufferedRule;
+    // Written by the UI thread, read by whichever thread runs the worker.
+    SettingsChannel<Settings> m_Settings;
+    uint64_t m_AppliedRuleVersion = 0;
 
-    std::atomic<int64_t> m_TickDelayMs = 0;
+    // Only touched by the step in progress.
+    AdaptiveStepController m_StepController;
+    bool m_StepControllerActive = false;
 
     std::atomic<std::chrono::steady_clock::time_point> m_LastUpdate;
 
     std::array<GameGrid, 3> m_Buffers{}; // Triple buffer pattern
     std::atomic<size_t> m_SnapshotIndex;
+    size_t m_WorkerIndex = 1;
+    std::chrono::steady_clock::time_point m_NextFrame;
 
     std::function<void()> m_OnStop;
     bool m_OneStep = false;
 
-    std::stop_source m_RunStopSource;
+    // How many steps ahead speculation runs.
+    constexpr static size_t SpeculationDepth = 4;
 
-    bool m_ResumeReady = false;
-    std::mutex m_ResumeMutex;
-    std::condition_variable_any m_ResumeCondition;
+    // Whether scheduled steps speculate instead of running the simulation.
+    bool m_Speculating = false;
+    BigInt m_SpeculatedStepCount;
+    std::mutex m_SpeculationMutex;
+    // Set when speculation stopped for want of room in the queue.
+    bool m_SpeculationParked = false;
+    // The grid the speculated steps start from, followed by its successors.
+    std::optional<GameGrid> m_SpeculationBase;
+    std::deque<GameGrid> m_Speculated;
 
-    std::atomic<bool> m_IsRunning{};
-    std::binary_semaphore m_PauseSemaphore{0};
+    std::stop_source m_RunStopSource;
 
-    std::jthread m_Thread;
+    std::atomic<bool> m_IsRunning{};
+    std::atomic<bool> m_Focused{};
 };
 } // namespace gol
 
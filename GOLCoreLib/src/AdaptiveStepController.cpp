@@ -0,0 +1,62 @@
+#include "AdaptiveStepController.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace gol {
+
+AdaptiveStepController::AdaptiveStepController(
+    std::chrono::duration<double> target)
+    : m_Target(target) {}
+
+void AdaptiveStepController::Reset() {
+    SetLog2Step(0);
+    m_Cooldown = 0;
+}
+
+void AdaptiveStepController::Record(std::chrono::duration<double> elapsed,
+                                    size_t cacheBytesBefore,
+                                    size_t cacheBytesAfter) {
+    // A burst of new nodes means the pattern outgrew what the cache has seen,
+    // and the next, larger jump would likely grow it even more.
+    if (cacheBytesAfter > cacheBytesBefore &&
+        cacheBytesAfter - cacheBytesBefore >=
+            std::max(MinSpikeBytes, cacheBytesBefore / 4UZ)) {
+        Shrink(1);
+        return;
+    }
+
+    if (elapsed > m_Target) {
+        // Work grows at most linearly with the step, so halving once per
+        // doubling of the overshoot brings the update back within budget.
+        const auto overshoot = elapsed / m_Target;
+        Shrink(std::max(
+            1, static_cast<int32_t>(std::ceil(std::log2(overshoot)))));
+        return;
+    }
+
+    if (elapsed * 2.0 >= m_Target)
+        return;
+
+    if (m_Cooldown > 0) {
+        --m_Cooldown;
+        return;
+    }
+    SetLog2Step(std::min(m_Log2Step + 1, MaxLog2Step));
+}
+
+void AdaptiveStepController::SetLog2Step(int32_t log2Step) {
+    if (log2Step == m_Log2Step)
+        return;
+    m_Log2Step = log2Step;
+    m_StepCount = BigOne << m_Log2Step;
+}
+
+void AdaptiveStepController::Shrink(int32_t levels) {
+    SetLog2Step(std::max(m_Log2Step - levels, 0));
+    m_Cooldown = GrowCooldown;
+}
+} // namespace gol
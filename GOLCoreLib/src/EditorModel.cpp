@@ -4,7 +4,10 @@
 #include <limits>
 #include <locale>
 #include <optional>
+#include <ranges>
+#include <span>
 #include <string>
+#include <vector>
 
 #include "EditorModel.hpp"
 #include "GameEnums.hpp"
@@ -12,6 +15,7 @@
 #include "Graphics2D.hpp"
 #include "SimulationCommand.hpp"
 #include "SimulationWorker.hpp"
+#include "Tracing.hpp"
 #include "VersionManager.hpp"
 
 namespace gol {
@@ -32,8 +36,9 @@ bool ShouldExecuteInline(const SimulationCommand& cmd) {
 } // namespace
 
 EditorModel::EditorModel(uint32_t id, const std::filesystem::path& path,
-                         Size2 gridSize)
-    : m_Grid(gridSize), m_Worker(std::make_unique<SimulationWorker>(id)),
+                         Size2 gridSize, bool shareNodes)
+    : m_Cache(shareNodes), m_Grid(gridSize),
+      m_Worker(std::make_unique<SimulationWorker>(m_Cache.Index())),
       m_CurrentFilePath(path), m_EditorID(id) {
     // Seed history with the initial state so first undo restores correctly.
     m_VersionManager.PushChange(VersionState{.Universe = m_Grid});
@@ -80,6 +85,27 @@ void EditorModel::CheckStopStep() {
 void EditorModel::ApplySettings(const SimulationSettings& settings) {
     m_Worker->SetTickDelayMs(settings.TickDelayMs);
     m_Worker->SetStepCount(settings.StepCount);
+    m_Worker->SetAutoStep(settings.AutoStep);
+    m_Timeline.SetInterval(settings.TimelineInterval);
+}
+
+void EditorModel::SetFocused(bool focused) { m_Worker->SetFocused(focused); }
+
+void EditorModel::SpeculateSteps() {
+    if (m_State != SimulationState::Paused || IsEditBusy()) {
+        m_Worker->StopSpeculating();
+        return;
+    }
+    m_Worker->Speculate(m_Grid);
+}
+
+void EditorModel::RecordTimeline() {
+    if (m_State == SimulationState::Simulation) {
+        if (const auto* snapshot = m_Worker->GetResult())
+            m_Timeline.Record(*snapshot);
+    } else if (m_State == SimulationState::Paused && !IsEditBusy()) {
+        m_Timeline.Record(m_Grid);
+    }
 }
 
 void EditorModel::TryPushVersionChange(
@@ -94,6 +120,8 @@ void EditorModel::TryPushVersionChange(const VersionState& change) {
 SimulationState EditorModel::HandleStart() {
     m_SelectionManager.Deselect(m_Grid);
     m_InitialGrid = m_Grid;
+    m_Timeline.Clear();
+    m_Timeline.Branch(m_Grid);
     return StartSimulation();
 }
 
@@ -103,7 +131,8 @@ SimulationState EditorModel::HandleClear() {
 
     const std::string oldRuleStr{m_Grid.GetRuleString()};
     m_Grid = GameGrid{m_Grid.Size()};
-    m_Grid.SetRule(*LifeRule::Make(oldRuleStr), oldRuleStr);
+    m_Grid.SetRule(oldRuleStr);
+    m_Timeline.Clear();
 
     TryPushVersionChange(VersionState{.Universe = m_Grid});
     return SimulationState::Paint;
@@ -113,8 +142,7 @@ SimulationState EditorModel::HandleReset() {
     StopSimulation(false);
     m_SelectionManager.Deselect(m_Grid);
     m_Grid = m_InitialGrid;
-    m_Worker->BufferRule(
-        std::make_unique<LifeRule>(*LifeRule::Make(m_Grid.GetRuleString())));
+    m_Worker->BufferRule(m_Grid.GetRuleString());
     return SimulationState::Paint;
 }
 
@@ -122,8 +150,7 @@ SimulationState EditorModel::HandleRestart() {
     StopSimulation(false);
     m_SelectionManager.Deselect(m_Grid);
     m_Grid = m_InitialGrid;
-    m_Worker->BufferRule(
-        std::make_unique<LifeRule>(*LifeRule::Make(m_Grid.GetRuleString())));
+    m_Worker->BufferRule(m_Grid.GetRuleString());
     return StartSimulation();
 }
 
@@ -134,32 +161,46 @@ SimulationState EditorModel::HandlePause() {
 
 SimulationState EditorModel::HandleResume() {
     m_SelectionManager.Deselect(m_Grid);
+    // Edits made while paused change every later generation.
+    m_Timeline.Branch(m_Grid);
     return StartSimulation();
 }
 
 SimulationState EditorModel::HandleStep() {
     m_SelectionManager.Deselect(m_Grid);
-    if (m_State == SimulationState::Paint)
+    if (m_State == SimulationState::Paint) {
         m_InitialGrid = m_Grid;
+        m_Timeline.Clear();
+    }
+    m_Timeline.Branch(m_Grid);
+    if (auto next = m_Worker->TakeSpeculated(m_Grid)) {
+        m_Grid = std::move(*next);
+        return SimulationState::Paused;
+    }
     m_Worker->Start(m_Grid, true, [this] {
         m_StopStepCommand.store(true, std::memory_order_release);
     });
     return SimulationState::Stepping;
 }
 
+SimulationState EditorModel::HandleRewind(const BigInt& generation) {
+    m_SelectionManager.Deselect(m_Grid);
+    if (auto rewound = m_Timeline.Rewind(generation))
+        m_Grid = std::move(*rewound);
+    return m_State;
+}
+
 SimulationState EditorModel::HandleRuleChange(std::string_view ruleStr) {
-    const auto rule = *LifeRule::Make(ruleStr);
-    m_Worker->BufferRule(std::make_unique<LifeRule>(rule));
+    m_Worker->BufferRule(ruleStr);
 
     const auto oldSize = m_Grid.Size();
-    const auto ruleBounds = rule.Bounds().value_or(Rect{});
+    const auto ruleSize = *GameGrid::ExtractDimensions(ruleStr);
 
     // Always set the rule on the grid
-    m_Grid.SetRule(rule, ruleStr);
+    m_Grid.SetRule(ruleStr);
 
-    if (oldSize != ruleBounds.Size()) {
-        m_Grid = GameGrid{std::move(m_Grid),
-                          rule.Bounds() ? rule.Bounds()->Size() : Size2{}};
+    if (oldSize != ruleSize) {
+        m_Grid = GameGrid{std::move(m_Grid), ruleSize};
     }
 
     m_SelectionManager.SetSelectionRule(ruleStr);
@@ -202,8 +243,7 @@ SimulationState EditorModel::HandleUndo() {
     auto versionChanges = m_VersionManager.Undo();
     if (versionChanges) {
         m_SelectionManager.HandleVersionChange(m_Grid, *versionChanges);
-        m_Worker->BufferRule(std::make_unique<LifeRule>(
-            *LifeRule::Make(m_Grid.GetRuleString())));
+        m_Worker->BufferRule(m_Grid.GetRuleString());
     }
     return m_State;
 }
@@ -212,8 +252,7 @@ SimulationState EditorModel::HandleRedo() {
     auto versionChanges = m_VersionManager.Redo();
     if (versionChanges) {
         m_SelectionManager.HandleVersionChange(m_Grid, *versionChanges);
-        m_Worker->BufferRule(std::make_unique<LifeRule>(
-            *LifeRule::Make(m_Grid.GetRuleString())));
+        m_Worker->BufferRule(m_Grid.GetRuleString());
     }
     return m_State;
 }
@@ -320,12 +359,17 @@ void EditorModel::BeginPaintChange() {
     m_VersionManager.BeginPaintChange(m_Grid, m_State);
 }
 
-void EditorModel::PaintCell(Vec2 pos, bool value) {
-    if (*m_Grid.Get(pos.X, pos.Y) == value) {
+void EditorModel::PaintCells(std::span<const Vec2> positions, bool value) {
+    const auto changed = positions | std::views::filter([&](Vec2 pos) {
+                             const auto alive = m_Grid.Get(pos);
+                             return alive && *alive != value;
+                         }) |
+                         std::ranges::to<std::vector>();
+    if (changed.empty()) {
         return;
     }
 
-    m_Grid.Set(pos.X, pos.Y, value);
+    m_Grid.SetMany(changed, value);
     m_VersionManager.AddPaintChange(m_Grid, m_State);
 }
 
@@ -361,6 +405,7 @@ bool EditorModel::IsMutatingCommand(const SimulationCommand& cmd) const {
                    [](const PauseCommand&) { return false; },
                    [](const ResumeCommand&) { return false; },
                    [](const StepCommand&) { return false; },
+                   [](const RewindCommand&) { return true; },
                    [](const CameraPositionCommand&) { return false; },
                    [](const CameraZoomCommand&) { return false; },
                    [](const SaveCommand&) { return false; },
@@ -403,14 +448,18 @@ bool EditorModel::TryStartCommand(const SimulationCommand& cmd,
 
     std::scoped_lock lock{m_CommandMutex};
     if (ShouldExecuteInline(cmd)) {
-        HashQuadtree::SetCacheIndex(m_EditorID);
+        HashQuadtree::SetCacheIndex(m_Cache.Index());
         m_InlineCommandResult = ExecuteCommandImmediate(cmd, context);
         return true;
     }
 
+    // The command edits the grid from another thread, so the speculated steps
+    // must not still be reading it or the cache.
+    m_Worker->StopSpeculating();
     m_InFlightCommand = std::async(
         std::launch::async, [this, command = cmd, commandContext = context]() {
-            HashQuadtree::SetCacheIndex(m_EditorID);
+            GOL_TRACE_ZONE("EditorModel::ExecuteCommand");
+            HashQuadtree::SetCacheIndex(m_Cache.Index());
             return ExecuteCommandImmediate(command, commandContext);
         });
     return true;
@@ -443,7 +492,7 @@ std::optional<ExecuteCommandResult> EditorModel::PollCommandResult() {
 ExecuteCommandResult
 EditorModel::ExecuteCommand(const SimulationCommand& cmd,
                             const ExecuteCommandContext& context) {
-    HashQuadtree::SetCacheIndex(m_EditorID);
+    HashQuadtree::SetCacheIndex(m_Cache.Index());
     return ExecuteCommandImmediate(cmd, context);
 }
 
@@ -508,6 +557,10 @@ EditorModel::ExecuteCommandImmediate(const SimulationCommand& cmd,
             [this](const StepCommand&) {
                 return ExecuteCommandResult{.State = HandleStep()};
             },
+            [this](const RewindCommand& command) {
+                return ExecuteCommandResult{
+                    .State = HandleRewind(command.Generation)};
+            },
             [this](const SelectionBoundsCommand& command) {
                 return ExecuteCommandResult{
                     .State = SetSelectionBounds(command.Bounds)};
@@ -683,12 +736,7 @@ EditorModel::ExecuteCommandImmediate(const SimulationCommand& cmd,
                     BeginPaintChange();
                 }
 
-                for (const auto point : command.Points) {
-                    if (!InBounds(point)) {
-                        continue;
-                    }
-                    PaintCell(point, command.Value);
-                }
+                PaintCells(command.Points, command.Value);
 
                 return ExecuteCommandResult{.State = m_State};
             }},
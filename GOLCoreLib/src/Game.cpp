@@ -20,9 +20,11 @@
 #include "Logging.hpp"
 #include "PopupWindow.hpp"
 #include "PresetSelectionResult.hpp"
+#include "Profiler.hpp"
 #include "SimulationCommand.hpp"
 #include "SimulationControlResult.hpp"
 #include "SimulationEditor.hpp"
+#include "SimulationScheduler.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -110,6 +112,7 @@ void Game::Begin() {
 
         auto controlResult = m_Control.Update(m_State);
         auto presetResult = m_PresetSelection.Update(m_State);
+        m_Profiler.Update();
         UpdateEditors(controlResult, presetResult);
 
         EndFrame();
@@ -173,6 +176,11 @@ void Game::UpdateEditors(SimulationControlResult& controlResult,
         }
     }
 
+    SimulationScheduler::Get().SetBackgroundPolicy(
+        controlResult.Settings.Background);
+    for (auto i = 0UZ; i < m_Editors.size(); i++)
+        m_Editors[i]->SetFocused(i == m_LastActive);
+
     ImGui::End();
 }
 
@@ -238,6 +246,7 @@ void Game::HandleUnsaved(PopupWindowState state) {
 }
 
 void Game::BeginFrame() {
+    Profiler::Get().Sample();
     GL_DEBUG(glfwPollEvents());
     GL_DEBUG(glClear(GL_COLOR_BUFFER_BIT));
 
@@ -285,6 +294,7 @@ void Game::InitDockspace(uint32_t dockspaceID, ImVec2 windowSize) {
                                               nullptr, &rightID);
 
     ImGui::DockBuilderDockWindow("Presets", downID);
+    ImGui::DockBuilderDockWindow("Profiler", downID);
     ImGui::DockBuilderDockWindow("###EditorDockspace", rightID);
     ImGui::DockBuilderDockWindow("Simulation Control", leftID);
     ImGui::DockBuilderFinish(dockspaceID);
@@ -360,13 +370,11 @@ bool Game::CheckForNewEditors(const SimulationControlResult& controlResult) {
     if (fileOpen)
         return false;
 
-    if (m_EditorCounter >= HashQuadtree::MaxCacheCount) {
-        return false;
-    }
     m_Editors.emplace_back(std::make_unique<SimulationEditor>(
         m_EditorCounter++, filePath,
         Size2{m_Window.Bounds.Width, m_Window.Bounds.Height},
-        Size2{DefaultGridWidth, DefaultGridHeight}));
+        Size2{DefaultGridWidth, DefaultGridHeight},
+        controlResult.Settings.ShareNodes));
 
     CreateEditorDockspace();
 
@@ -0,0 +1,50 @@
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <imgui.h>
+#include <locale>
+#include <string>
+
+#include "Profiler.hpp"
+#include "ProfilerPanel.hpp"
+
+namespace gol {
+void ProfilerPanel::Update() {
+    ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_NoNav);
+
+    for (auto i = 0UZ; i < Profiler::MetricCount; ++i)
+        DisplayMetric(static_cast<ProfileMetric>(i));
+
+    ImGui::End();
+}
+
+void ProfilerPanel::DisplayMetric(ProfileMetric metric) {
+    const auto& profiler = Profiler::Get();
+    const auto& info = Profiler::Metrics[static_cast<size_t>(metric)];
+    const auto latest = profiler.Latest(metric);
+
+    const auto overlay = [&] {
+        switch (info.Kind) {
+        case ProfileMetricKind::CallTime:
+        case ProfileMetricKind::FrameTime:
+            return std::format("{}: {:.2f} ms", info.Name, latest);
+        case ProfileMetricKind::Rate:
+            return std::format(std::locale{""}, "{}: {:L}/s", info.Name,
+                               static_cast<uint64_t>(latest));
+        case ProfileMetricKind::Memory:
+            return std::format("{}: {:.1f} MiB", info.Name, latest);
+        }
+        return std::string{info.Name};
+    }();
+
+    const auto history = profiler.History(metric);
+    ImGui::PushID(static_cast<int>(metric));
+    ImGui::PlotHistogram(
+        "##History", history.data(), static_cast<int>(history.size()),
+        static_cast<int>(profiler.HistoryOffset()), overlay.c_str(), 0.f,
+        FLT_MAX,
+        {ImGui::GetContentRegionAvail().x, ImGui::GetFontSize() * 3.f});
+    ImGui::PopID();
+}
+} // namespace gol
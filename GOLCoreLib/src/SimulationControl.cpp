@@ -138,7 +138,12 @@ SimulationControlResult SimulationControl::Update(const EditorResult& state) {
                          .Algorithm = m_StepWidget.CurrentAlgorithm(),
                          .TickDelayMs = m_DelayWidget.TickDelayMs(),
                          .HyperSpeed = m_StepWidget.IsHyperSpeed(),
-                         .GridLines = m_DelayWidget.ShowGridLines()},
+                         .AutoStep = m_StepWidget.IsAutoStep(),
+                         .TimelineInterval =
+                             m_TimelineWidget.CheckpointInterval(),
+                         .GridLines = m_DelayWidget.ShowGridLines(),
+                         .ShareNodes = m_DelayWidget.ShareNodes(),
+                         .Background = m_DelayWidget.Background()},
             .FromShortcut = fromShortcut};
 }
 } // namespace gol
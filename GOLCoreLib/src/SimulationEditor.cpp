@@ -82,8 +82,9 @@ std::string FormatHoverPoint(glm::dvec2 worldCellPos) {
 
 SimulationEditor::SimulationEditor(uint32_t id,
                                    const std::filesystem::path& path,
-                                   Size2 windowSize, Size2 gridSize)
-    : m_Model(id, path, gridSize),
+                                   Size2 windowSize, Size2 gridSize,
+                                   bool shareNodes)
+    : m_Model(id, path, gridSize, shareNodes),
       m_Graphics(std::filesystem::path("resources") / "shader",
                  windowSize.Width, windowSize.Height, {0.1f, 0.1f, 0.1f, 1.f}),
       m_FileErrorWindow("File Error", [](auto) {}),
@@ -106,7 +107,7 @@ SimulationEditor::Update(std::optional<bool> activeOverride,
                          const SimulationControlResult& controlArgs,
                          const PresetSelectionResult& presetArgs) {
     PollPendingCommandResult();
-    HashQuadtree::SetCacheIndex(m_Model.EditorID());
+    HashQuadtree::SetCacheIndex(m_Model.CacheIndex());
 
     auto displayResult = DisplaySimulation(
         (controlArgs.Command || !presetArgs.ClipboardText.empty()) &&
@@ -159,6 +160,9 @@ SimulationEditor::Update(std::optional<bool> activeOverride,
         m_Model.SetState(SimulationState::Paused);
     }
 
+    m_Model.SpeculateSteps();
+    m_Model.RecordTimeline();
+
     m_Model.SetState([this, &graphicsArgs]() {
         switch (m_Model.State()) {
             using enum SimulationState;
@@ -330,17 +334,6 @@ SimulationEditor::DisplaySimulation(bool grabFocus) {
         "%s", std::format(std::locale{""}, "Population: {:L}", totalPopulation)
                   .c_str());
 
-#ifdef _DEBUG
-    auto currentTime = glfwGetTime();
-    frameCounter++;
-    if (currentTime - lastTime > 1.0) {
-        fps = frameCounter;
-        frameCounter = 0;
-        lastTime += 1.0;
-    }
-    ImGui::Text("%d FPS", fps);
-#endif
-
     const auto mousePos = Vec2F{ImGui::GetMousePos()};
     const auto viewportBounds = ViewportBounds();
     const auto hoverText = [&] -> std::optional<std::string> {
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+
+#include "SimulationScheduler.hpp"
+#include "SimulationWorker.hpp"
+
+namespace gol {
+SimulationScheduler& SimulationScheduler::Get() {
+    // One thread is left for the UI and rasterization.
+    static SimulationScheduler scheduler{
+        std::max(2U, std::thread::hardware_concurrency()) - 1U};
+    return scheduler;
+}
+
+SimulationScheduler::SimulationScheduler(size_t threadCount) {
+    m_Threads.reserve(threadCount);
+    for (auto i = 0UZ; i < threadCount; ++i) {
+        m_Threads.emplace_back(
+            std::bind_front(&SimulationScheduler::ThreadLoop, this));
+    }
+}
+
+SimulationScheduler::~SimulationScheduler() {
+    for (auto& thread : m_Threads)
+        thread.request_stop();
+    m_Threads.clear();
+}
+
+void SimulationScheduler::Schedule(
+    SimulationWorker& worker, std::chrono::steady_clock::time_point readyAt,
+    TaskPriority priority) {
+    {
+        std::scoped_lock lock{m_Mutex};
+        m_Queue.push_back({.Worker = &worker,
+                           .ReadyAt = readyAt,
+                           .ScheduledAt = std::chrono::steady_clock::now(),
+                           .Priority = priority});
+        ++m_Changes;
+    }
+    m_Condition.notify_one();
+}
+
+void SimulationScheduler::Cancel(SimulationWorker& worker) {
+    std::unique_lock lock{m_Mutex};
+    std::erase_if(m_Queue,
+                  [&](const Task& task) { return task.Worker == &worker; });
+
+    // Keeps a step in progress from queueing the worker again.
+    m_Cancelling.push_back(&worker);
+    m_Condition.wait(lock, [&] {
+        return !std::ranges::contains(m_Running, &worker);
+    });
+    std::erase(m_Cancelling, &worker);
+}
+
+void SimulationScheduler::SetBackgroundPolicy(BackgroundPolicy policy) {
+    {
+        std::scoped_lock lock{m_Mutex};
+        if (m_Policy == policy)
+            return;
+        m_Policy = policy;
+        ++m_Changes;
+    }
+    m_Condition.notify_all();
+}
+
+void SimulationScheduler::FocusChanged() {
+    {
+        std::scoped_lock lock{m_Mutex};
+        ++m_Changes;
+    }
+    m_Condition.notify_all();
+}
+
+void SimulationScheduler::ThreadLoop(std::stop_token stopToken) {
+    std::unique_lock lock{m_Mutex};
+    while (!stopToken.stop_requested()) {
+        auto wakeAt = std::optional<std::chrono::steady_clock::time_point>{};
+        const auto task = NextTask(wakeAt);
+        if (!task) {
+            const auto changes = m_Changes;
+            const auto changed = [&] { return m_Changes != changes; };
+            if (wakeAt)
+                m_Condition.wait_until(lock, stopToken, *wakeAt, changed);
+            else
+                m_Condition.wait(lock, stopToken, changed);
+            continue;
+        }
+
+        m_Running.push_back(task->Worker);
+        lock.unlock();
+        const auto readyAt = task->Worker->Step();
+        lock.lock();
+
+        // A worker woken by another thread may already be running again, so
+        // only this step's entry is removed.
+        m_Running.erase(std::ranges::find(m_Running, task->Worker));
+        if (readyAt && !std::ranges::contains(m_Cancelling, task->Worker)) {
+            m_Queue.push_back(
+                {.Worker = task->Worker,
+                 .ReadyAt = *readyAt,
+                 .ScheduledAt = std::chrono::steady_clock::now(),
+                 .Priority = task->Priority});
+        }
+        // Wakes Cancel, as well as threads that may now run the worker.
+        ++m_Changes;
+        m_Condition.notify_all();
+    }
+}
+
+std::optional<SimulationScheduler::Task> SimulationScheduler::NextTask(
+    std::optional<std::chrono::steady_clock::time_point>& wakeAt) {
+    const auto now = std::chrono::steady_clock::now();
+
+    auto best = m_Queue.end();
+    auto bestPriority = std::chrono::steady_clock::time_point{};
+    // Idle tasks are chosen separately and only run when nothing else can.
+    auto bestIdle = m_Queue.end();
+    for (auto it = m_Queue.begin(); it != m_Queue.end(); ++it) {
+        const auto readyAt = EffectiveReadyAt(*it);
+        if (!readyAt)
+            continue;
+        if (*readyAt > now) {
+            wakeAt = wakeAt ? std::min(*wakeAt, *readyAt) : *readyAt;
+            continue;
+        }
+
+        if (it->Priority == TaskPriority::Idle) {
+            if (bestIdle == m_Queue.end() || it->ReadyAt < bestIdle->ReadyAt)
+                bestIdle = it;
+            continue;
+        }
+
+        // Whoever has waited longest goes first, with the focused editor
+        // counted as having waited an extra ThrottleInterval. It wins every
+        // tie, but cannot starve the others when threads are scarce.
+        const auto priority =
+            it->Worker->IsFocused() ? *readyAt - ThrottleInterval : *readyAt;
+        if (best == m_Queue.end() || priority < bestPriority) {
+            best = it;
+            bestPriority = priority;
+        }
+    }
+
+    if (best == m_Queue.end())
+        best = bestIdle;
+    if (best == m_Queue.end())
+        return std::nullopt;
+
+    const auto task = *best;
+    m_Queue.erase(best);
+    return task;
+}
+
+std::optional<std::chrono::steady_clock::time_point>
+SimulationScheduler::EffectiveReadyAt(const Task& task) const {
+    if (task.Worker->IsFocused())
+        return task.ReadyAt;
+
+    switch (m_Policy) {
+    case BackgroundPolicy::Run:
+        return task.ReadyAt;
+    case BackgroundPolicy::Throttle:
+        return std::max(task.ReadyAt, task.ScheduledAt + ThrottleInterval);
+    case BackgroundPolicy::Pause:
+        return std::nullopt;
+    }
+    return task.ReadyAt;
+}
+} // namespace gol
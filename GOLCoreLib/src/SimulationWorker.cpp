@@ -1,122 +1,167 @@
 #include "SimulationWorker.hpp"
 
 #include <chrono>
-#include <condition_variable>
-#include <print>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <utility>
+
+#include "HashQuadtree.hpp"
+#include "Profiler.hpp"
+#include "SimulationScheduler.hpp"
 
 namespace gol {
+namespace {
+// Whether `a` and `b` hold the same universe. Nodes are canonical, so this
+// takes no walk of either tree.
+bool SameUniverse(const GameGrid& a, const GameGrid& b) {
+    return a.Data().Data() == b.Data().Data() &&
+           a.Data().SeedOffset() == b.Data().SeedOffset() &&
+           a.Data().CalculateDepth() == b.Data().CalculateDepth() &&
+           a.Size() == b.Size() && a.Generation() == b.Generation() &&
+           a.GetRuleString() == b.GetRuleString();
+}
+} // namespace
 
 SimulationWorker::SimulationWorker(size_t cacheIndex)
-    : m_CacheIndex(cacheIndex),
-      m_Thread(std::bind_front(&SimulationWorker::ThreadLoop, this)) {}
+    : m_CacheIndex(cacheIndex) {}
 
-SimulationWorker::~SimulationWorker() {
-    m_RunStopSource.request_stop();
-    HashQuadtree::ClearCache();
-}
+SimulationWorker::~SimulationWorker() { Halt(); }
 
-void SimulationWorker::ThreadLoop(std::stop_token threadStopToken) {
-    HashQuadtree::SetCacheIndex(m_CacheIndex);
-    while (true) {
-        {
-            std::unique_lock lock{m_ResumeMutex};
-            m_ResumeCondition.wait(lock, threadStopToken,
-                                   [&] { return m_ResumeReady; });
-            if (m_BufferedRule != nullptr) {
-                for (auto i = 0UZ; i < 3UZ; i++) {
-                    m_Buffers[i].SetRule(*m_BufferedRule);
-                }
-                m_BufferedRule = nullptr;
-            }
-
-            if (threadStopToken.stop_requested()) {
-                return;
-            }
-            m_ResumeReady = false;
-        }
+std::optional<std::chrono::steady_clock::time_point> SimulationWorker::Step() {
+    if (m_Speculating) {
+        return SpeculateStep();
+    }
 
-        auto runStopToken = m_RunStopSource.get_token();
-        SimulationLoop(runStopToken);
+    const auto runStopToken = m_RunStopSource.get_token();
+    if (runStopToken.stop_requested()) {
+        return std::nullopt;
+    }
 
-        if (m_OneStep && !runStopToken.stop_requested()) {
-            m_OnStop();
-        }
+    // Pool threads serve every editor, so the cache is bound on each step.
+    HashQuadtree::SetCacheIndex(m_CacheIndex);
+    m_LastUpdate.store(std::chrono::steady_clock::now(),
+                       std::memory_order_relaxed);
 
-        m_PauseSemaphore.release();
+    const auto& settings = m_Settings.Read();
+    const bool autoStep = !m_OneStep && settings.AutoStep;
+    if (autoStep && !m_StepControllerActive) {
+        m_StepController.Reset();
     }
-}
+    m_StepControllerActive = autoStep;
 
-size_t SimulationWorker::SimulationLoop(std::stop_token runStopToken) {
-    auto workerIndex = 1UZ;
-    auto backIndex = 2UZ;
+    const auto& stepCount =
+        autoStep ? m_StepController.StepCount() : settings.StepCount;
 
-    std::condition_variable_any sleepCondition{};
-    std::mutex sleepMutex{};
-    auto nextFrame = std::chrono::steady_clock::now();
+    const auto cacheBytesBefore = HashQuadtree::CacheMemoryUsage();
+    const auto updateStart = std::chrono::steady_clock::now();
+    const auto generations = [&] {
+        ScopedTimer timer{ProfileMetric::WorkerUpdate};
+        return m_Buffers[m_WorkerIndex].Update(stepCount, runStopToken);
+    }();
+    if (autoStep && !runStopToken.stop_requested()) {
+        m_StepController.Record(std::chrono::steady_clock::now() - updateStart,
+                                cacheBytesBefore,
+                                HashQuadtree::CacheMemoryUsage());
+    }
+    Profiler::Get().AddCount(
+        ProfileMetric::Generations,
+        generations > std::numeric_limits<uint64_t>::max()
+            ? std::numeric_limits<uint64_t>::max()
+            : generations.convert_to<uint64_t>());
 
-    while (!runStopToken.stop_requested()) {
-        m_LastUpdate.store(std::chrono::steady_clock::now(),
-                           std::memory_order_relaxed);
+    if (runStopToken.stop_requested()) {
+        return std::nullopt;
+    }
 
-        auto stepCount = [&] {
-            std::scoped_lock locK{m_StepCountMutex};
-            return m_StepCount;
-        }();
+    // Publish the worker buffer as the new snapshot, get back the old one
+    m_WorkerIndex =
+        m_SnapshotIndex.exchange(m_WorkerIndex, std::memory_order_acq_rel);
 
-        m_Buffers[workerIndex].Update(stepCount, runStopToken);
+    if (m_OneStep) {
+        m_OnStop();
+        return std::nullopt;
+    }
 
-        if (runStopToken.stop_requested()) {
-            break;
-        }
+    const auto tickDelayMs = settings.TickDelayMs;
+    if (tickDelayMs <= 0) {
+        m_NextFrame = std::chrono::steady_clock::now();
+        return m_NextFrame;
+    }
+    m_NextFrame += std::chrono::milliseconds{tickDelayMs};
+    return m_NextFrame;
+}
 
-        // Publish workerIndex as the new snapshot, get back the old one
-        backIndex =
-            m_SnapshotIndex.exchange(workerIndex, std::memory_order_acq_rel);
-        workerIndex = backIndex;
+std::optional<std::chrono::steady_clock::time_point>
+SimulationWorker::SpeculateStep() {
+    const auto stopToken = m_RunStopSource.get_token();
+    if (stopToken.stop_requested()) {
+        return std::nullopt;
+    }
 
-        if (m_OneStep) {
-            break;
+    auto next = [&] -> std::optional<GameGrid> {
+        std::scoped_lock lock{m_SpeculationMutex};
+        if (m_Speculated.size() >= SpeculationDepth) {
+            m_SpeculationParked = true;
+            return std::nullopt;
         }
+        return m_Speculated.empty() ? *m_SpeculationBase : m_Speculated.back();
+    }();
+    // Leave the queue once it is full. TakeSpeculated makes room and
+    // schedules the worker again.
+    if (!next) {
+        return std::nullopt;
+    }
 
-        const auto tickDelayMs = m_TickDelayMs.load(std::memory_order_relaxed);
-        if (tickDelayMs > 0) {
-            nextFrame += std::chrono::milliseconds{tickDelayMs};
-
-            std::unique_lock lock{sleepMutex};
-            sleepCondition.wait_until(lock, runStopToken, nextFrame,
-                                      [] { return false; });
-        }
+    HashQuadtree::SetCacheIndex(m_CacheIndex);
+    next->Update(m_SpeculatedStepCount, stopToken);
+    if (stopToken.stop_requested()) {
+        return std::nullopt;
     }
 
-    return workerIndex;
+    std::scoped_lock lock{m_SpeculationMutex};
+    m_Speculated.push_back(std::move(*next));
+    return std::chrono::steady_clock::now();
+}
+
+void SimulationWorker::Halt() {
+    m_RunStopSource.request_stop();
+    SimulationScheduler::Get().Cancel(*this);
 }
 
 void SimulationWorker::Start(GameGrid& initialGrid, bool oneStep,
                              const std::function<void()>& onStop) {
+    StopSpeculating();
     if (m_IsRunning.exchange(true, std::memory_order_acq_rel)) {
-        m_RunStopSource.request_stop();
-        m_PauseSemaphore.acquire();
+        Halt();
     }
     m_RunStopSource = {};
 
     m_Buffers[0] = initialGrid;
     m_Buffers[1] = initialGrid;
     m_Buffers[2] = initialGrid;
+    // No step is in progress here, so this thread may read the settings, and
+    // the steps of this run are ordered after it by the scheduler.
+    if (const auto& settings = m_Settings.Read();
+        settings.RuleVersion != m_AppliedRuleVersion) {
+        for (auto& buffer : m_Buffers) {
+            buffer.SetRule(settings.Rule);
+        }
+        m_AppliedRuleVersion = settings.RuleVersion;
+    }
     m_SnapshotIndex.store(0UZ, std::memory_order_release);
+    m_WorkerIndex = 1UZ;
 
-    {
-        std::scoped_lock lock{m_ResumeMutex};
-        m_OneStep = oneStep;
-        m_OnStop = onStop;
-        m_ResumeReady = true;
-    }
-    m_ResumeCondition.notify_one();
+    m_OneStep = oneStep;
+    m_OnStop = onStop;
+    m_NextFrame = std::chrono::steady_clock::now();
+    SimulationScheduler::Get().Schedule(*this, m_NextFrame);
 }
 
 GameGrid SimulationWorker::Stop() {
     if (m_IsRunning.exchange(false, std::memory_order_acq_rel)) {
-        m_RunStopSource.request_stop();
-        m_PauseSemaphore.acquire();
+        Halt();
     }
     return m_Buffers[m_SnapshotIndex.load(std::memory_order_relaxed)];
 }
@@ -126,12 +171,27 @@ bool SimulationWorker::IsRunning() {
 }
 
 void SimulationWorker::SetStepCount(const BigInt& stepCount) {
-    std::scoped_lock lock{m_StepCountMutex};
-    m_StepCount = stepCount;
+    if (m_Settings.Current().StepCount == stepCount) {
+        return;
+    }
+    m_Settings.Edit().StepCount = stepCount;
+    m_Settings.Publish();
+}
+
+void SimulationWorker::SetAutoStep(bool autoStep) {
+    if (m_Settings.Current().AutoStep == autoStep) {
+        return;
+    }
+    m_Settings.Edit().AutoStep = autoStep;
+    m_Settings.Publish();
 }
 
 void SimulationWorker::SetTickDelayMs(int64_t tickDelayMs) {
-    m_TickDelayMs.store(tickDelayMs, std::memory_order_relaxed);
+    if (m_Settings.Current().TickDelayMs == tickDelayMs) {
+        return;
+    }
+    m_Settings.Edit().TickDelayMs = tickDelayMs;
+    m_Settings.Publish();
 }
 
 const GameGrid* SimulationWorker::GetResult() const {
@@ -146,7 +206,83 @@ std::chrono::duration<float> SimulationWorker::GetTimeSinceLastUpdate() const {
            m_LastUpdate.load(std::memory_order_relaxed);
 }
 
-void SimulationWorker::BufferRule(std::unique_ptr<LifeRule> rule) {
-    m_BufferedRule = std::move(rule);
+void SimulationWorker::BufferRule(std::string_view ruleString) {
+    auto& settings = m_Settings.Edit();
+    settings.Rule = ruleString;
+    ++settings.RuleVersion;
+    m_Settings.Publish();
+}
+
+void SimulationWorker::Speculate(const GameGrid& grid) {
+    const auto& stepCount = m_Settings.Current().StepCount;
+    if (m_Speculating && m_SpeculatedStepCount == stepCount) {
+        std::scoped_lock lock{m_SpeculationMutex};
+        if (SameUniverse(*m_SpeculationBase, grid)) {
+            return;
+        }
+    }
+
+    StopSpeculating();
+    if (m_IsRunning.load(std::memory_order_acquire)) {
+        return;
+    }
+    m_RunStopSource = {};
+
+    // Edits to the editor's grid on the UI thread now share its cache with
+    // the speculated steps, so it must be locked until they stop.
+    HashQuadtree::SetCacheConcurrent(m_CacheIndex, true);
+    m_Speculating = true;
+    m_SpeculationParked = false;
+    m_SpeculatedStepCount = stepCount;
+    m_SpeculationBase = grid;
+    SimulationScheduler::Get().Schedule(
+        *this, std::chrono::steady_clock::now(),
+        SimulationScheduler::TaskPriority::Idle);
+}
+
+std::optional<GameGrid> SimulationWorker::TakeSpeculated(const GameGrid& grid) {
+    if (!m_Speculating ||
+        m_SpeculatedStepCount != m_Settings.Current().StepCount) {
+        return std::nullopt;
+    }
+
+    std::unique_lock lock{m_SpeculationMutex};
+    if (m_Speculated.empty() || !SameUniverse(*m_SpeculationBase, grid)) {
+        return std::nullopt;
+    }
+    m_SpeculationBase = std::move(m_Speculated.front());
+    m_Speculated.pop_front();
+    auto result = m_SpeculationBase;
+    const bool parked = std::exchange(m_SpeculationParked, false);
+    lock.unlock();
+
+    if (parked) {
+        SimulationScheduler::Get().Schedule(
+            *this, std::chrono::steady_clock::now(),
+            SimulationScheduler::TaskPriority::Idle);
+    }
+    return result;
+}
+
+void SimulationWorker::StopSpeculating() {
+    if (!m_Speculating) {
+        return;
+    }
+    Halt();
+    m_Speculating = false;
+    m_SpeculationParked = false;
+    m_SpeculationBase = std::nullopt;
+    m_Speculated.clear();
+    HashQuadtree::SetCacheConcurrent(m_CacheIndex, false);
+}
+
+bool SimulationWorker::IsFocused() const {
+    return m_Focused.load(std::memory_order_relaxed);
+}
+
+void SimulationWorker::SetFocused(bool focused) {
+    if (m_Focused.exchange(focused, std::memory_order_relaxed) != focused) {
+        SimulationScheduler::Get().FocusChanged();
+    }
 }
 } // namespace gol
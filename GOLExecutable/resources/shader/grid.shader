@@ -5,12 +5,15 @@ layout (location = 0) in vec2 a_Position;
 layout (location = 1) in vec2 a_TexCoord;
 
 uniform mat4 u_MVP;
+// Left, top, right and bottom edges of the quad in world space.
+uniform vec4 u_QuadBounds;
 
 out vec2 v_TexCoord;
 
 void main()
 {
-    gl_Position = u_MVP * vec4(a_Position, 0.0, 1.0);
+    vec2 position = mix(u_QuadBounds.xy, u_QuadBounds.zw, a_Position);
+    gl_Position = u_MVP * vec4(position, 0.0, 1.0);
     v_TexCoord = a_TexCoord;
 }
 
@@ -20,15 +23,30 @@ void main()
 layout(location = 0) out vec4 color;
 
 uniform vec4 u_Color;
-uniform sampler2D u_StateTex;
+// Either one bit per texel, eight to a byte of u_StateTex with the leftmost
+// in the lowest bit, or one byte per texel holding its shade.
+uniform usampler2D u_StateTex;
+uniform vec2 u_TexelCount;
+uniform int u_BitsPerTexel;
 
 in vec2 v_TexCoord;
 
 void main() 
 {
-    float alive = texture(u_StateTex, v_TexCoord).r;
-    if (alive < 0.5) {
+    ivec2 texel = min(ivec2(v_TexCoord * u_TexelCount),
+                      ivec2(u_TexelCount) - 1);
+    if (u_BitsPerTexel == 1) {
+        uint packed = texelFetch(u_StateTex, ivec2(texel.x >> 3, texel.y), 0).r;
+        if (((packed >> uint(texel.x & 7)) & 1u) == 0u) {
+            discard;
+        }
+        color = u_Color;
+        return;
+    }
+
+    uint shade = texelFetch(u_StateTex, texel, 0).r;
+    if (shade == 0u) {
         discard;
     }
-    color = u_Color;
-}
\ No newline at end of file
+    color = vec4(u_Color.rgb * (float(shade) / 255.0), u_Color.a);
+}
@@ -68,8 +68,9 @@ GLWrapper<Generator, Deleter>::GLWrapper(
 template <auto Generator, auto Deleter>
 auto& GLWrapper<Generator, Deleter>::operator=(
     GLWrapper<Generator, Deleter>&& other) noexcept {
+    // Swapping hands the old object to `other`, which deletes it.
     if (this != &other)
-        m_ID = std::exchange(other.m_ID, 0);
+        std::swap(m_ID, other.m_ID);
     return *this;
 }
 
@@ -8,16 +8,22 @@
 #include <filesystem>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <unordered_set>
 #include <vector>
 
 #include "Camera.hpp"
 #include "GLBuffer.hpp"
 #include "Graphics2D.hpp"
+#include "GridRasterizer.hpp"
 #include "HashQuadtree.hpp"
 #include "Logging.hpp"
+#include "PixelUploadRing.hpp"
+#include "Profiler.hpp"
 #include "ShaderManager.hpp"
+#include "Tracing.hpp"
 
 namespace gol {
 struct GraphicsHandlerArgs {
@@ -69,19 +75,32 @@ class GraphicsHandler {
     BigRect VisibleBounds(const GraphicsHandlerArgs& args) const;
 
     void InitGridBuffer();
-    void EnsureGridStateTexture(Size2 size);
-
-    struct GridBlitInfo {
-        int64_t MinCoarseX = 0;
-        int64_t MinCoarseY = 0;
-        int32_t Width = 0;
-        int32_t Height = 0;
-        float CellScale = 1.f;
+
+    struct GridState {
+        GLTexture Texture{};
+        Size2 TextureSize{};
+        // The contents of the texture, or empty when they could not be keyed
+        // and so must always be redrawn.
+        std::optional<RasterKey> Key{};
+        // The contents most recently sent to be rasterized.
+        std::optional<RasterKey> RequestedKey{};
+        GridBlitInfo BlitInfo{};
+        uint64_t LastUsed = 0;
+        std::shared_ptr<RasterSlot> Slot = std::make_shared<RasterSlot>();
     };
 
-    GridBlitInfo GenerateStateBuffer(Vec2 offset, int32_t minLevel,
-                                     const std::ranges::input_range auto& grid,
-                                     const GraphicsHandlerArgs& args);
+    // Returns the state whose current or requested key matches, or otherwise
+    // the least recently used one.
+    GridState& FindGridState(const std::optional<RasterKey>& key);
+    void EnsureGridStateTexture(GridState& state, Size2 size);
+    void UploadGridState(GridState& state, std::span<const uint8_t> buffer,
+                         const GridBlitInfo& blitInfo);
+
+    // Works out which cells a state buffer must cover, or nothing if none of
+    // them are visible.
+    std::optional<RasterWindow>
+    CalculateRasterWindow(Vec2 offset, int32_t minLevel,
+                          const GraphicsHandlerArgs& args) const;
 
     RectF GridToScreenBounds(Rect region,
                              const GraphicsHandlerArgs& args) const;
@@ -103,15 +122,22 @@ class GraphicsHandler {
     ShaderManager m_GridShader;
     ShaderManager m_SelectionShader;
 
+    // Only used for ranges other than HashQuadtree, which are rasterized on
+    // the UI thread.
     std::vector<uint8_t> m_StateBuffer;
 
     GLVertexArray m_GridVAO;
     GLVertexArray m_GridLineVAO;
     GLVertexArray m_SelectionVAO;
 
+    // A unit quad, stretched over the state texture by u_QuadBounds.
     GLBuffer m_CellBuffer;
-    GLTexture m_GridStateTexture;
-    Size2 m_GridStateTextureSize{};
+    PixelUploadRing m_StateUploads;
+
+    // One state for the grid and one for the selection, which are both drawn
+    // every frame.
+    std::array<GridState, 2> m_GridStates{};
+    uint64_t m_GridStateUseCount = 0;
 
     GLBuffer m_GridLineBuffer;
 
@@ -123,128 +149,11 @@ class GraphicsHandler {
     GLRenderBuffer m_RenderBuffer;
 };
 
-auto GraphicsHandler::GenerateStateBuffer(
-    Vec2 offset, int32_t minLevel, const std::ranges::input_range auto& grid,
-    const GraphicsHandlerArgs& args) -> GridBlitInfo {
-    m_StateBuffer.clear();
-
-    const auto gridInfo = CalculateGridLineInfo(offset, args);
-    const auto minCellX =
-        std::floor(gridInfo.UpperLeft.X / args.CellSize.Width);
-    const auto minCellY =
-        std::floor(gridInfo.UpperLeft.Y / args.CellSize.Height);
-    const auto maxCellX =
-        std::ceil(gridInfo.LowerRight.X / args.CellSize.Width) - 1.f;
-    const auto maxCellY =
-        std::ceil(gridInfo.LowerRight.Y / args.CellSize.Height) - 1.f;
-
-    if (maxCellX < minCellX || maxCellY < minCellY) {
-        return {};
-    }
-
-    const auto cellScale = std::pow(2.0, static_cast<double>(minLevel));
-    const auto minCoarseX =
-        static_cast<int64_t>(std::floor(minCellX / cellScale));
-    const auto minCoarseY =
-        static_cast<int64_t>(std::floor(minCellY / cellScale));
-    const auto maxCoarseX =
-        static_cast<int64_t>(std::floor(maxCellX / cellScale));
-    const auto maxCoarseY =
-        static_cast<int64_t>(std::floor(maxCellY / cellScale));
-
-    if (maxCoarseX < minCoarseX || maxCoarseY < minCoarseY) {
-        return {};
-    }
-
-    const auto width64 = maxCoarseX - minCoarseX + 1;
-    const auto height64 = maxCoarseY - minCoarseY + 1;
-    if (width64 <= 0 || height64 <= 0 ||
-        width64 > std::numeric_limits<int32_t>::max() ||
-        height64 > std::numeric_limits<int32_t>::max()) {
-        return {};
-    }
-
-    const auto width = static_cast<int32_t>(width64);
-    const auto height = static_cast<int32_t>(height64);
-
-    m_StateBuffer.assign(
-        static_cast<size_t>(width) * static_cast<size_t>(height), 0);
-
-    const auto pushToBuffer = [&]<typename VecType>(const VecType& vec) {
-        const auto x = static_cast<double>(vec.X + offset.X);
-        const auto y = static_cast<double>(vec.Y + offset.Y);
-        if (x < minCellX || x > maxCellX || y < minCellY || y > maxCellY) {
-            return;
-        }
-
-        const auto coarseX = static_cast<int64_t>(std::floor(x / cellScale));
-        const auto coarseY = static_cast<int64_t>(std::floor(y / cellScale));
-        if (coarseX < minCoarseX || coarseX > maxCoarseX ||
-            coarseY < minCoarseY || coarseY > maxCoarseY) {
-            return;
-        }
-
-        const auto col = static_cast<int32_t>(coarseX - minCoarseX);
-        const auto rowFromTop = static_cast<int32_t>(coarseY - minCoarseY);
-        const auto row = height - 1 - rowFromTop;
-        const auto index =
-            static_cast<size_t>(row) * static_cast<size_t>(width) +
-            static_cast<size_t>(col);
-
-        m_StateBuffer[index] = 255;
-    };
-
-    if constexpr (std::is_same_v<std::decay_t<decltype(grid)>, HashQuadtree>) {
-        const auto visibleWorldBounds = VisibleBounds(args);
-        const auto boundsX = visibleWorldBounds.X - BigInt{offset.X};
-        const auto boundsY = visibleWorldBounds.Y - BigInt{offset.Y};
-        const auto boundsWidth = visibleWorldBounds.Width;
-        const auto boundsHeight = visibleWorldBounds.Height;
-
-        const auto fitsInt32 = [&] {
-            const static BigInt int32Min{std::numeric_limits<int32_t>::min()};
-            const static BigInt int32Max{std::numeric_limits<int32_t>::max()};
-
-            if (boundsWidth < BigZero || boundsHeight < BigZero) {
-                return false;
-            }
-            if (boundsWidth > int32Max || boundsHeight > int32Max) {
-                return false;
-            }
-
-            const auto right = boundsX + boundsWidth;
-            const auto bottom = boundsY + boundsHeight;
-
-            return boundsX >= int32Min && boundsX <= int32Max &&
-                   boundsY >= int32Min && boundsY <= int32Max &&
-                   right >= int32Min && right <= int32Max &&
-                   bottom >= int32Min && bottom <= int32Max;
-        }();
-
-        if (fitsInt32) {
-            const Rect localBounds{boundsX.convert_to<int32_t>(),
-                                   boundsY.convert_to<int32_t>(),
-                                   boundsWidth.convert_to<int32_t>(),
-                                   boundsHeight.convert_to<int32_t>()};
-            grid.ForEachCell(pushToBuffer, localBounds, minLevel);
-            return {minCoarseX, minCoarseY, width, height,
-                    static_cast<float>(cellScale)};
-        }
-        const BigRect localBounds{boundsX, boundsY, boundsWidth, boundsHeight};
-        grid.ForEachCell(pushToBuffer, localBounds, minLevel);
-    } else {
-        for (const auto vec : grid) {
-            pushToBuffer(vec, 1);
-        }
-    }
-
-    return {minCoarseX, minCoarseY, width, height,
-            static_cast<float>(cellScale)};
-}
-
 void GraphicsHandler::DrawGrid(Vec2 offset,
                                const std::ranges::input_range auto& grid,
                                const GraphicsHandlerArgs& args) {
+    GOL_TRACE_ZONE("GraphicsHandler::DrawGrid");
+    ScopedTimer timer{ProfileMetric::DrawGrid};
     FrameBufferBinder binder{m_FrameBuffer};
 
     auto matrix = Camera.OrthographicProjection(args.ViewportBounds.Size());
@@ -280,20 +189,65 @@ void GraphicsHandler::DrawGrid(Vec2 offset,
         }
     }();
 
-    const auto blitInfo = GenerateStateBuffer(offset, minLevel, grid, args);
+    // Walking the tree is the bulk of a frame, so quadtrees are rasterized
+    // on a background thread and the UI thread uploads the newest finished
+    // image. Nothing is redone when the visible contents have not changed.
+    GridState* state = nullptr;
+    if constexpr (std::is_same_v<std::decay_t<decltype(grid)>,
+                                 HashQuadtree>) {
+        const RasterKey key{grid.Data(),          grid.SeedOffset(),
+                            grid.CalculateDepth(), offset,
+                            Camera.Center,        Camera.Zoom,
+                            args.ViewportBounds,  args.CellSize};
+        state = &FindGridState(key);
+
+        if (auto result = state->Slot->TakeResult()) {
+            UploadGridState(*state, result->Buffer, result->Window.Blit);
+            state->Key = result->Key;
+            state->Slot->ReturnBuffer(std::move(result->Buffer));
+        }
+
+        if (state->Key != key && state->RequestedKey != key) {
+            if (const auto window =
+                    CalculateRasterWindow(offset, minLevel, args)) {
+                AsyncGridRasterizer::Get().Submit(state->Slot, grid, *window,
+                                                  key);
+                state->RequestedKey = key;
+            } else {
+                state->Key = key;
+                state->RequestedKey = std::nullopt;
+                state->BlitInfo = {};
+            }
+        }
+    } else {
+        const auto window = CalculateRasterWindow(offset, minLevel, args);
+        state = &FindGridState(std::nullopt);
+        state->Key = std::nullopt;
+        state->BlitInfo = {};
+        if (window) {
+            const auto& blit = window->Blit;
+            {
+                ScopedTimer rasterizeTimer{ProfileMetric::Rasterize};
+                m_StateBuffer.assign(blit.PackedSize(), 0);
+                for (const auto vec : grid)
+                    window->MarkCell(m_StateBuffer, vec);
+            }
+            UploadGridState(*state, m_StateBuffer, blit);
+        }
+    }
+
+    const auto& blitInfo = state->BlitInfo;
     if (blitInfo.Width <= 0 || blitInfo.Height <= 0) {
         GL_DEBUG(glBindVertexArray(0));
         return;
     }
 
-    EnsureGridStateTexture({blitInfo.Width, blitInfo.Height});
-
     GL_DEBUG(glActiveTexture(GL_TEXTURE0));
-    GL_DEBUG(glBindTexture(GL_TEXTURE_2D, m_GridStateTexture.ID()));
-    GL_DEBUG(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
-    GL_DEBUG(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, blitInfo.Width,
-                             blitInfo.Height, GL_RED, GL_UNSIGNED_BYTE,
-                             m_StateBuffer.data()));
+    GL_DEBUG(glBindTexture(GL_TEXTURE_2D, state->Texture.ID()));
+    m_GridShader.AttachUniformVec2(
+        "u_TexelCount", {static_cast<float>(blitInfo.Width),
+                         static_cast<float>(blitInfo.Height)});
+    m_GridShader.AttachUniformInt("u_BitsPerTexel", blitInfo.BitsPerTexel);
 
     const auto scaledCellWidth =
         static_cast<double>(args.CellSize.Width) * blitInfo.CellScale;
@@ -311,15 +265,8 @@ void GraphicsHandler::DrawGrid(Vec2 offset,
     const auto bottom =
         top + static_cast<float>(scaledCellHeight * blitInfo.Height);
 
-    const std::array<float, 24> quadVertices = {
-        left,  top,    0.f, 1.f, left,  bottom, 0.f, 0.f,
-        right, bottom, 1.f, 0.f, right, bottom, 1.f, 0.f,
-        right, top,    1.f, 1.f, left,  top,    0.f, 1.f,
-    };
-
-    GL_DEBUG(glBindBuffer(GL_ARRAY_BUFFER, m_CellBuffer.ID()));
-    GL_DEBUG(glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices),
-                          quadVertices.data(), GL_DYNAMIC_DRAW));
+    m_GridShader.AttachUniformVec4("u_QuadBounds",
+                                   {left, top, right, bottom});
 
     GL_DEBUG(glDrawArrays(GL_TRIANGLES, 0, 6));
 
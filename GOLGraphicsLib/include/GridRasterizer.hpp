@@ -0,0 +1,224 @@
+#ifndef GridRasterizer_hpp_
+#define GridRasterizer_hpp_
+
+#include <ankerl/unordered_dense.h>
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <glm/glm.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "Graphics2D.hpp"
+#include "HashQuadtree.hpp"
+#include "LifeNode.hpp"
+
+namespace gol {
+struct GridBlitInfo {
+    int64_t MinCoarseX = 0;
+    int64_t MinCoarseY = 0;
+    int32_t Width = 0;
+    int32_t Height = 0;
+    float CellScale = 1.f;
+    // Rows run from top to bottom. 1 when each texel is a single cell, packed
+    // eight to a byte with the leftmost texel in the lowest bit. 8 when texels
+    // cover several cells and each byte holds the shade of their population
+    // density.
+    int32_t BitsPerTexel = 1;
+
+    constexpr int32_t PackedWidth() const {
+        return (Width * BitsPerTexel + 7) / 8;
+    }
+    constexpr size_t PackedSize() const {
+        return static_cast<size_t>(PackedWidth()) *
+               static_cast<size_t>(Height);
+    }
+};
+
+// The part of a universe covered by one state buffer. Each texel covers a
+// square of 2^MinLevel cells.
+struct RasterWindow {
+    GridBlitInfo Blit{};
+    int32_t MinLevel = 0;
+    Vec2 Offset{};
+
+    // The visible cells, after applying Offset.
+    double MinCellX = 0.0;
+    double MinCellY = 0.0;
+    double MaxCellX = 0.0;
+    double MaxCellY = 0.0;
+
+    // The visible cells, before applying Offset.
+    BigRect LocalBounds{};
+
+    // Marks the texel containing the cell at `pos` as fully alive, if it is
+    // visible.
+    template <typename VecType>
+    void MarkCell(std::span<uint8_t> buffer, const VecType& pos) const;
+
+    // Gives the texel at (coarseX, coarseY) the shade `value`, or just marks
+    // it alive if texels are single bits.
+    void MarkTexel(std::span<uint8_t> buffer, int64_t coarseX, int64_t coarseY,
+                   uint8_t value = 255) const;
+};
+
+// Everything that determines the contents of a state buffer. A root pointer
+// can only be reused for different contents once an arena has been freed,
+// which DestroyedArenas tells apart.
+struct RasterKey {
+    const LifeNode* Root;
+    Vec2L SeedOffset;
+    int32_t Depth;
+    Vec2 Offset;
+    glm::dvec2 CameraCenter;
+    float Zoom;
+    Rect ViewportBounds;
+    Size2F CellSize;
+    uint64_t DestroyedArenas = LifeNodeArena::DestroyedCount();
+
+    bool operator==(const RasterKey&) const = default;
+};
+
+// Fills state buffers from a HashQuadtree. Single-bit buffers are written by
+// HashQuadtree::RasterizeRegion. For shaded buffers, nodes are canonical, so
+// each node of level MinLevel + TileLevels is rasterized once into a tile and
+// tiles are copied into place a row at a time. Densities come from the
+// population stored in each node, so shading costs nothing beyond the walk.
+class GridRasterizer {
+  public:
+    constexpr static int32_t TileLevels = 4;
+    constexpr static int32_t TileSize = 1 << TileLevels;
+    constexpr static size_t MaxTileCount = 1UZ << 14UZ;
+    // The shade of the sparsest live texel, so that sparse regions stay
+    // visible.
+    constexpr static uint8_t MinShade = 64;
+
+    // The shade of a texel covering `node`, which has level `level`.
+    static uint8_t DensityShade(const LifeNode* node, int32_t level);
+
+    // Never creates nodes, so `tree` may belong to another thread's cache as
+    // long as its nodes are alive.
+    void Rasterize(const HashQuadtree& tree, const RasterWindow& window,
+                   std::vector<uint8_t>& buffer);
+
+  private:
+    // The shade of texel (x, y) is stored in tile[y][x].
+    using Tile = std::array<std::array<uint8_t, TileSize>, TileSize>;
+
+    struct TileKey {
+        const LifeNode* Node;
+        int32_t MinLevel;
+
+        bool operator==(const TileKey&) const = default;
+    };
+
+    struct TileKeyHash {
+        size_t operator()(const TileKey& key) const noexcept;
+    };
+
+    // The cells covered by a single-bit buffer, relative to the tree, if
+    // they fit in a Rect.
+    static std::optional<Rect> PackedRegion(const RasterWindow& window);
+
+    // Returns the tile for `node`, rasterizing it if it has not been seen at
+    // this level before.
+    const Tile& FindTile(const LifeNode* node, int32_t minLevel);
+
+    // Copies the visible part of a tile whose upper-left texel lies at
+    // (coarseX, coarseY) into `buffer`.
+    static void BlitTile(const Tile& tile, int64_t coarseX, int64_t coarseY,
+                         const GridBlitInfo& target,
+                         std::span<uint8_t> buffer);
+
+  private:
+    ankerl::unordered_dense::map<TileKey, Tile, TileKeyHash> m_Tiles;
+    // Tiles are dropped once an arena is freed, since their nodes' addresses
+    // may be reused.
+    uint64_t m_DestroyedArenas = 0;
+};
+
+// The latest finished state buffer for one texture, handed from the
+// rasterization thread to the UI thread.
+class RasterSlot {
+  public:
+    struct Result {
+        std::vector<uint8_t> Buffer;
+        RasterWindow Window;
+        RasterKey Key;
+    };
+
+    // Returns the newest result not yet taken, if there is one.
+    std::optional<Result> TakeResult();
+
+    // Hands back a buffer from TakeResult once it has been uploaded, so that
+    // it can be filled again without reallocating.
+    void ReturnBuffer(std::vector<uint8_t> buffer);
+
+  private:
+    friend class AsyncGridRasterizer;
+
+    std::mutex m_Mutex;
+    std::optional<Result> m_Ready;
+    std::vector<uint8_t> m_Spare;
+};
+
+// A single background thread, shared by every GraphicsHandler, that walks
+// quadtrees into state buffers so that the UI thread only has to upload them.
+class AsyncGridRasterizer {
+  public:
+    static AsyncGridRasterizer& Get();
+
+    AsyncGridRasterizer(const AsyncGridRasterizer&) = delete;
+    auto& operator=(const AsyncGridRasterizer&) = delete;
+
+    // Queues `tree` to be rasterized into `slot`, replacing any request for
+    // the same slot that has not started yet.
+    void Submit(const std::shared_ptr<RasterSlot>& slot,
+                const HashQuadtree& tree, const RasterWindow& window,
+                const RasterKey& key);
+
+  private:
+    AsyncGridRasterizer();
+
+    void ThreadLoop(std::stop_token stopToken);
+
+  private:
+    struct Job {
+        std::weak_ptr<RasterSlot> Slot;
+        HashQuadtree Tree;
+        RasterWindow Window;
+        RasterKey Key;
+    };
+
+    std::mutex m_Mutex;
+    std::condition_variable_any m_Condition;
+    std::deque<Job> m_Jobs;
+
+    GridRasterizer m_Rasterizer;
+
+    std::jthread m_Thread;
+};
+
+template <typename VecType>
+void RasterWindow::MarkCell(std::span<uint8_t> buffer,
+                            const VecType& pos) const {
+    const auto x = static_cast<double>(pos.X + Offset.X);
+    const auto y = static_cast<double>(pos.Y + Offset.Y);
+    if (x < MinCellX || x > MaxCellX || y < MinCellY || y > MaxCellY) {
+        return;
+    }
+
+    const auto cellScale = static_cast<double>(Blit.CellScale);
+    MarkTexel(buffer, static_cast<int64_t>(std::floor(x / cellScale)),
+              static_cast<int64_t>(std::floor(y / cellScale)));
+}
+} // namespace gol
+
+#endif
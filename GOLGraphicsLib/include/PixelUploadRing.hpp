@@ -0,0 +1,60 @@
+#ifndef PixelUploadRing_hpp_
+#define PixelUploadRing_hpp_
+
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "GLBuffer.hpp"
+#include "Graphics2D.hpp"
+
+namespace gol {
+// Streams pixels into textures through a ring of sections in one persistently
+// mapped pixel unpack buffer. Writing a section only waits on the fence of the
+// upload that last used it, so the copy into the texture overlaps with
+// rendering instead of stalling in the driver. Without ARB_buffer_storage, or
+// if the buffer cannot be mapped, uploads fall back to glTexSubImage2D from
+// client memory.
+class PixelUploadRing {
+  public:
+    constexpr static size_t SectionCount = 3;
+
+    PixelUploadRing() = default;
+
+    PixelUploadRing(const PixelUploadRing&) = delete;
+    auto& operator=(const PixelUploadRing&) = delete;
+
+    // The mapping and fences move with the buffer, so that only one ring ever
+    // unmaps or deletes them.
+    PixelUploadRing(PixelUploadRing&& other) noexcept;
+    PixelUploadRing& operator=(PixelUploadRing&& other) noexcept;
+
+    ~PixelUploadRing();
+
+    // Uploads single-channel unsigned integer `pixels` covering `size` into
+    // the texture bound to GL_TEXTURE_2D.
+    void Upload(std::span<const uint8_t> pixels, Size2 size);
+
+  private:
+    // Makes every section at least `sectionSize` bytes large, recreating the
+    // buffer if it is too small.
+    void Reserve(size_t sectionSize);
+    void WaitForSection(size_t section);
+    void Release();
+    static void UploadFromClient(std::span<const uint8_t> pixels, Size2 size);
+
+  private:
+    GLBuffer m_Buffer{};
+    uint8_t* m_Mapped = nullptr;
+    size_t m_SectionSize = 0;
+    size_t m_Section = 0;
+    std::array<GLsync, SectionCount> m_Fences{};
+    // Set once mapping fails, after which every upload comes from client
+    // memory.
+    bool m_MapFailed = false;
+};
+} // namespace gol
+
+#endif
@@ -1,9 +1,11 @@
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <filesystem>
 #include <limits>
 #include <set>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -11,6 +13,7 @@
 #include "Graphics2D.hpp"
 #include "GraphicsHandler.hpp"
 #include "Logging.hpp"
+#include "Profiler.hpp"
 #include "ShaderManager.hpp"
 
 namespace gol {
@@ -85,8 +88,15 @@ GraphicsHandler::GraphicsHandler(const std::filesystem::path& shaderDirectory,
 void GraphicsHandler::InitGridBuffer() {
     GL_DEBUG(glBindVertexArray(m_GridVAO.ID()));
 
+    // Corners as fractions of the quad, followed by texture coordinates.
+    // State textures store their top row first, so both run the same way.
+    constexpr static std::array<float, 24> quadVertices = {
+        0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 1.f, 1.f, 1.f, 1.f,
+        1.f, 1.f, 1.f, 1.f, 1.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+    };
     GL_DEBUG(glBindBuffer(GL_ARRAY_BUFFER, m_CellBuffer.ID()));
-    GL_DEBUG(glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW));
+    GL_DEBUG(glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices),
+                          quadVertices.data(), GL_STATIC_DRAW));
     GL_DEBUG(glEnableVertexAttribArray(0));
     GL_DEBUG(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 4,
                                    nullptr));
@@ -112,19 +122,33 @@ void GraphicsHandler::InitGridBuffer() {
     GL_DEBUG(glBindVertexArray(0));
 }
 
-void GraphicsHandler::EnsureGridStateTexture(Size2 size) {
+GraphicsHandler::GridState&
+GraphicsHandler::FindGridState(const std::optional<RasterKey>& key) {
+    auto state = std::ranges::find_if(m_GridStates, [&](const auto& state) {
+        return key && (state.Key == key || state.RequestedKey == key);
+    });
+    if (state == m_GridStates.end()) {
+        state = std::ranges::min_element(m_GridStates, {},
+                                         &GridState::LastUsed);
+    }
+
+    state->LastUsed = ++m_GridStateUseCount;
+    return *state;
+}
+
+void GraphicsHandler::EnsureGridStateTexture(GridState& state, Size2 size) {
     if (size.Width <= 0 || size.Height <= 0) {
         return;
     }
 
-    if (size.Width == m_GridStateTextureSize.Width &&
-        size.Height == m_GridStateTextureSize.Height) {
+    if (size.Width == state.TextureSize.Width &&
+        size.Height == state.TextureSize.Height) {
         return;
     }
 
-    GL_DEBUG(glBindTexture(GL_TEXTURE_2D, m_GridStateTexture.ID()));
-    GL_DEBUG(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, size.Width, size.Height, 0,
-                          GL_RED, GL_UNSIGNED_BYTE, nullptr));
+    GL_DEBUG(glBindTexture(GL_TEXTURE_2D, state.Texture.ID()));
+    GL_DEBUG(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, size.Width, size.Height,
+                          0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr));
     GL_DEBUG(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
     GL_DEBUG(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
     GL_DEBUG(
@@ -132,7 +156,77 @@ void GraphicsHandler::EnsureGridStateTexture(Size2 size) {
     GL_DEBUG(
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
 
-    m_GridStateTextureSize = size;
+    state.TextureSize = size;
+}
+
+void GraphicsHandler::UploadGridState(GridState& state,
+                                      std::span<const uint8_t> buffer,
+                                      const GridBlitInfo& blitInfo) {
+    ScopedTimer timer{ProfileMetric::Upload};
+    state.BlitInfo = blitInfo;
+    if (blitInfo.Width <= 0 || blitInfo.Height <= 0) {
+        return;
+    }
+
+    const Size2 packedSize{blitInfo.PackedWidth(), blitInfo.Height};
+    EnsureGridStateTexture(state, packedSize);
+    GL_DEBUG(glBindTexture(GL_TEXTURE_2D, state.Texture.ID()));
+    m_StateUploads.Upload(buffer, packedSize);
+}
+
+std::optional<RasterWindow>
+GraphicsHandler::CalculateRasterWindow(Vec2 offset, int32_t minLevel,
+                                       const GraphicsHandlerArgs& args) const {
+    const auto gridInfo = CalculateGridLineInfo(offset, args);
+    const auto minCellX =
+        std::floor(gridInfo.UpperLeft.X / args.CellSize.Width);
+    const auto minCellY =
+        std::floor(gridInfo.UpperLeft.Y / args.CellSize.Height);
+    const auto maxCellX =
+        std::ceil(gridInfo.LowerRight.X / args.CellSize.Width) - 1.f;
+    const auto maxCellY =
+        std::ceil(gridInfo.LowerRight.Y / args.CellSize.Height) - 1.f;
+
+    if (maxCellX < minCellX || maxCellY < minCellY) {
+        return std::nullopt;
+    }
+
+    const auto cellScale = std::pow(2.0, static_cast<double>(minLevel));
+    const auto minCoarseX =
+        static_cast<int64_t>(std::floor(minCellX / cellScale));
+    const auto minCoarseY =
+        static_cast<int64_t>(std::floor(minCellY / cellScale));
+    const auto maxCoarseX =
+        static_cast<int64_t>(std::floor(maxCellX / cellScale));
+    const auto maxCoarseY =
+        static_cast<int64_t>(std::floor(maxCellY / cellScale));
+
+    if (maxCoarseX < minCoarseX || maxCoarseY < minCoarseY) {
+        return std::nullopt;
+    }
+
+    const auto width64 = maxCoarseX - minCoarseX + 1;
+    const auto height64 = maxCoarseY - minCoarseY + 1;
+    if (width64 <= 0 || height64 <= 0 ||
+        width64 > std::numeric_limits<int32_t>::max() ||
+        height64 > std::numeric_limits<int32_t>::max()) {
+        return std::nullopt;
+    }
+
+    const auto visibleWorldBounds = VisibleBounds(args);
+    return RasterWindow{
+        .Blit = {minCoarseX, minCoarseY, static_cast<int32_t>(width64),
+                 static_cast<int32_t>(height64), static_cast<float>(cellScale),
+                 minLevel > 0 ? 8 : 1},
+        .MinLevel = minLevel,
+        .Offset = offset,
+        .MinCellX = minCellX,
+        .MinCellY = minCellY,
+        .MaxCellX = maxCellX,
+        .MaxCellY = maxCellY,
+        .LocalBounds = {visibleWorldBounds.X - BigInt{offset.X},
+                        visibleWorldBounds.Y - BigInt{offset.Y},
+                        visibleWorldBounds.Width, visibleWorldBounds.Height}};
 }
 
 void GraphicsHandler::RescaleFrameBuffer(Rect windowBounds,
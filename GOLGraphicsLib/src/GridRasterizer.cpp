@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <utility>
+
+#include "GridRasterizer.hpp"
+#include "Profiler.hpp"
+
+namespace gol {
+namespace {
+// Calls `mark` with every non-empty node of level minLevel below `node` and
+// its texel, counting from the texel at (x, y).
+template <typename Func>
+void ForEachTexel(const LifeNode* node, int32_t level, int32_t minLevel,
+                  int32_t x, int32_t y, const Func& mark) {
+    if (node == FalseNode || node->IsEmpty) {
+        return;
+    }
+
+    if (level == minLevel) {
+        mark(node, x, y);
+        return;
+    }
+
+    const auto half = 1 << (level - minLevel - 1);
+    ForEachTexel(node->NorthWest, level - 1, minLevel, x, y, mark);
+    ForEachTexel(node->NorthEast, level - 1, minLevel, x + half, y, mark);
+    ForEachTexel(node->SouthWest, level - 1, minLevel, x, y + half, mark);
+    ForEachTexel(node->SouthEast, level - 1, minLevel, x + half, y + half,
+                 mark);
+}
+} // namespace
+
+void GridRasterizer::Rasterize(const HashQuadtree& tree,
+                               const RasterWindow& window,
+                               std::vector<uint8_t>& buffer) {
+    if (const auto destroyed = LifeNodeArena::DestroyedCount();
+        destroyed != m_DestroyedArenas) {
+        m_Tiles.clear();
+        m_DestroyedArenas = destroyed;
+    }
+
+    const auto& blit = window.Blit;
+    buffer.assign(blit.PackedSize(), 0);
+
+    const auto markCell = [&](const auto& pos) {
+        window.MarkCell(buffer, pos);
+    };
+
+    const auto& bounds = window.LocalBounds;
+    const auto fitsInt32 = [&] {
+        const static BigInt int32Min{std::numeric_limits<int32_t>::min()};
+        const static BigInt int32Max{std::numeric_limits<int32_t>::max()};
+
+        if (bounds.Width < BigZero || bounds.Height < BigZero) {
+            return false;
+        }
+        if (bounds.Width > int32Max || bounds.Height > int32Max) {
+            return false;
+        }
+
+        const auto right = bounds.X + bounds.Width;
+        const auto bottom = bounds.Y + bounds.Height;
+
+        return bounds.X >= int32Min && bounds.X <= int32Max &&
+               bounds.Y >= int32Min && bounds.Y <= int32Max &&
+               right >= int32Min && right <= int32Max && bottom >= int32Min &&
+               bottom <= int32Max;
+    }();
+
+    // Single-bit texels are whole cells, so the tree can write its 8x8 blocks
+    // straight into the buffer.
+    const auto depth = tree.CalculateDepth();
+    if (const auto region = PackedRegion(window);
+        region && depth <= HashQuadtree::MaxNodeWalkDepth) {
+        tree.RasterizeRegion(*region, window.MinLevel, buffer);
+        return;
+    }
+
+    // Only the big-integer walk and ForEachNode are free of node creation
+    // for every depth. ForEachCell with a Rect centers deeper trees first.
+    if (!fitsInt32 || depth > HashQuadtree::MaxNodeWalkDepth ||
+        window.MinLevel > depth) {
+        tree.ForEachCell(markCell, bounds, window.MinLevel);
+        return;
+    }
+
+    const Rect localBounds{bounds.X.convert_to<int32_t>(),
+                           bounds.Y.convert_to<int32_t>(),
+                           bounds.Width.convert_to<int32_t>(),
+                           bounds.Height.convert_to<int32_t>()};
+    const auto cellScale = static_cast<double>(blit.CellScale);
+    const auto toCoarse = [&](int64_t cell, int32_t offset) {
+        return static_cast<int64_t>(std::floor(
+            static_cast<double>(cell + offset) / cellScale));
+    };
+
+    const auto tileLevel = window.MinLevel + TileLevels;
+    if (tileLevel > depth) {
+        const auto markNode = [&](const LifeNode* node, Vec2L pos) {
+            window.MarkTexel(buffer, toCoarse(pos.X, window.Offset.X),
+                             toCoarse(pos.Y, window.Offset.Y),
+                             DensityShade(node, window.MinLevel));
+        };
+        tree.ForEachNode(markNode, localBounds, window.MinLevel);
+        return;
+    }
+
+    // Identical subtrees are shared, so repetitive universes only rasterize a
+    // few distinct tiles and copy them into place.
+    const auto blitNode = [&](const LifeNode* node, Vec2L pos) {
+        BlitTile(FindTile(node, window.MinLevel),
+                 toCoarse(pos.X, window.Offset.X),
+                 toCoarse(pos.Y, window.Offset.Y), blit, buffer);
+    };
+    tree.ForEachNode(blitNode, localBounds, tileLevel);
+}
+
+std::optional<Rect> GridRasterizer::PackedRegion(const RasterWindow& window) {
+    const auto& blit = window.Blit;
+    if (blit.BitsPerTexel != 1 || window.MinLevel != 0) {
+        return std::nullopt;
+    }
+
+    const auto left = blit.MinCoarseX - window.Offset.X;
+    const auto top = blit.MinCoarseY - window.Offset.Y;
+    constexpr auto int32Min = std::numeric_limits<int32_t>::min();
+    constexpr auto int32Max = std::numeric_limits<int32_t>::max();
+    if (left < int32Min || top < int32Min || left + blit.Width > int32Max ||
+        top + blit.Height > int32Max) {
+        return std::nullopt;
+    }
+
+    return Rect{static_cast<int32_t>(left), static_cast<int32_t>(top),
+                blit.Width, blit.Height};
+}
+
+uint8_t GridRasterizer::DensityShade(const LifeNode* node, int32_t level) {
+    if (node->Population == PopulationOverflow) {
+        return 255;
+    }
+
+    // Most patterns are far sparser than half full, so the square root
+    // spreads their densities over more of the range.
+    const auto density = static_cast<double>(node->Population) /
+                         std::ldexp(1.0, 2 * level);
+    return static_cast<uint8_t>(
+        MinShade + std::lround((255 - MinShade) * std::sqrt(density)));
+}
+
+size_t
+GridRasterizer::TileKeyHash::operator()(const TileKey& key) const noexcept {
+    return key.Node->Hash ^
+           (static_cast<uint64_t>(key.MinLevel) * 0x9E3779B97F4A7C15ULL);
+}
+
+auto GridRasterizer::FindTile(const LifeNode* node, int32_t minLevel)
+    -> const Tile& {
+    const TileKey key{node, minLevel};
+    if (const auto it = m_Tiles.find(key); it != m_Tiles.end()) {
+        return it->second;
+    }
+
+    if (m_Tiles.size() >= MaxTileCount) {
+        m_Tiles.clear();
+    }
+
+    auto& tile = m_Tiles[key];
+    const auto markTexel = [&](const LifeNode* texelNode, int32_t x,
+                               int32_t y) {
+        tile[y][x] = DensityShade(texelNode, minLevel);
+    };
+    ForEachTexel(node, minLevel + TileLevels, minLevel, 0, 0, markTexel);
+    return tile;
+}
+
+void GridRasterizer::BlitTile(const Tile& tile, int64_t coarseX,
+                              int64_t coarseY, const GridBlitInfo& target,
+                              std::span<uint8_t> buffer) {
+    const auto firstColumn =
+        std::max<int64_t>(0, target.MinCoarseX - coarseX);
+    const auto lastColumn = std::min<int64_t>(
+        TileSize, target.MinCoarseX + target.Width - coarseX);
+    if (firstColumn >= lastColumn) {
+        return;
+    }
+
+    const auto firstTexel = coarseX + firstColumn - target.MinCoarseX;
+    for (auto tileRow = 0; tileRow < TileSize; ++tileRow) {
+        const auto row = coarseY + tileRow - target.MinCoarseY;
+        if (row < 0 || row >= target.Height) {
+            continue;
+        }
+
+        const auto& shades = tile[tileRow];
+        std::copy(shades.begin() + firstColumn, shades.begin() + lastColumn,
+                  buffer.data() + row * target.Width + firstTexel);
+    }
+}
+
+void RasterWindow::MarkTexel(std::span<uint8_t> buffer, int64_t coarseX,
+                             int64_t coarseY, uint8_t value) const {
+    if (coarseX < Blit.MinCoarseX || coarseX >= Blit.MinCoarseX + Blit.Width ||
+        coarseY < Blit.MinCoarseY ||
+        coarseY >= Blit.MinCoarseY + Blit.Height) {
+        return;
+    }
+
+    const auto col = static_cast<size_t>(coarseX - Blit.MinCoarseX);
+    const auto row = static_cast<size_t>(coarseY - Blit.MinCoarseY);
+    auto& texels = buffer[row * static_cast<size_t>(Blit.PackedWidth()) +
+                          col * static_cast<size_t>(Blit.BitsPerTexel) / 8];
+
+    if (Blit.BitsPerTexel == 1) {
+        texels |= static_cast<uint8_t>(1U << (col % 8));
+    } else {
+        texels = std::max(texels, value);
+    }
+}
+
+std::optional<RasterSlot::Result> RasterSlot::TakeResult() {
+    std::scoped_lock lock{m_Mutex};
+    return std::exchange(m_Ready, std::nullopt);
+}
+
+void RasterSlot::ReturnBuffer(std::vector<uint8_t> buffer) {
+    std::scoped_lock lock{m_Mutex};
+    m_Spare = std::move(buffer);
+}
+
+AsyncGridRasterizer& AsyncGridRasterizer::Get() {
+    static AsyncGridRasterizer rasterizer{};
+    return rasterizer;
+}
+
+AsyncGridRasterizer::AsyncGridRasterizer()
+    : m_Thread(std::bind_front(&AsyncGridRasterizer::ThreadLoop, this)) {}
+
+void AsyncGridRasterizer::Submit(const std::shared_ptr<RasterSlot>& slot,
+                                 const HashQuadtree& tree,
+                                 const RasterWindow& window,
+                                 const RasterKey& key) {
+    {
+        std::scoped_lock lock{m_Mutex};
+        const auto queued = std::ranges::find_if(m_Jobs, [&](const Job& job) {
+            return job.Slot.lock() == slot;
+        });
+        if (queued != m_Jobs.end()) {
+            *queued = Job{slot, tree, window, key};
+        } else {
+            m_Jobs.push_back(Job{slot, tree, window, key});
+        }
+    }
+    m_Condition.notify_one();
+}
+
+void AsyncGridRasterizer::ThreadLoop(std::stop_token stopToken) {
+    while (true) {
+        auto job = [&] -> std::optional<Job> {
+            std::unique_lock lock{m_Mutex};
+            m_Condition.wait(lock, stopToken, [&] { return !m_Jobs.empty(); });
+            if (stopToken.stop_requested()) {
+                return std::nullopt;
+            }
+
+            auto next = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+            return next;
+        }();
+        if (!job) {
+            return;
+        }
+
+        auto slot = job->Slot.lock();
+        if (!slot) {
+            continue;
+        }
+
+        // The slot's spare buffer and the one it hands to the UI thread are
+        // double-buffered, so filling one never waits on the other's upload.
+        auto buffer = [&] {
+            std::scoped_lock lock{slot->m_Mutex};
+            return std::exchange(slot->m_Spare, {});
+        }();
+        {
+            ScopedTimer timer{ProfileMetric::Rasterize};
+            m_Rasterizer.Rasterize(job->Tree, job->Window, buffer);
+        }
+
+        std::scoped_lock lock{slot->m_Mutex};
+        if (slot->m_Ready) {
+            // The UI thread skipped this image, so reuse its buffer next time.
+            slot->m_Spare = std::move(slot->m_Ready->Buffer);
+        }
+        slot->m_Ready =
+            RasterSlot::Result{std::move(buffer), job->Window, job->Key};
+    }
+}
+} // namespace gol
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+#include "PixelUploadRing.hpp"
+
+namespace gol {
+PixelUploadRing::PixelUploadRing(PixelUploadRing&& other) noexcept
+    : m_Buffer(std::move(other.m_Buffer)),
+      m_Mapped(std::exchange(other.m_Mapped, nullptr)),
+      m_SectionSize(std::exchange(other.m_SectionSize, 0UZ)),
+      m_Section(std::exchange(other.m_Section, 0UZ)),
+      m_Fences(std::exchange(other.m_Fences, {})),
+      m_MapFailed(other.m_MapFailed) {}
+
+PixelUploadRing& PixelUploadRing::operator=(PixelUploadRing&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    // Unmaps this buffer before swapping it to `other`, which deletes it.
+    Release();
+    m_Buffer = std::move(other.m_Buffer);
+    m_Mapped = std::exchange(other.m_Mapped, nullptr);
+    m_SectionSize = std::exchange(other.m_SectionSize, 0UZ);
+    m_Section = std::exchange(other.m_Section, 0UZ);
+    m_Fences = std::exchange(other.m_Fences, {});
+    m_MapFailed = other.m_MapFailed;
+    return *this;
+}
+
+PixelUploadRing::~PixelUploadRing() { Release(); }
+
+void PixelUploadRing::Upload(std::span<const uint8_t> pixels, Size2 size) {
+    GL_DEBUG(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    if (!GLEW_ARB_buffer_storage || m_MapFailed) {
+        UploadFromClient(pixels, size);
+        return;
+    }
+
+    Reserve(pixels.size());
+    if (!m_Mapped) {
+        UploadFromClient(pixels, size);
+        return;
+    }
+    WaitForSection(m_Section);
+
+    const auto offset = m_Section * m_SectionSize;
+    std::memcpy(m_Mapped + offset, pixels.data(), pixels.size());
+
+    GL_DEBUG(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_Buffer.ID()));
+    GL_DEBUG(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.Width, size.Height,
+                             GL_RED_INTEGER, GL_UNSIGNED_BYTE,
+                             reinterpret_cast<const void*>(offset)));
+    GL_DEBUG(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+    GL_DEBUG(m_Fences[m_Section] =
+                 glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    m_Section = (m_Section + 1) % SectionCount;
+}
+
+void PixelUploadRing::Reserve(size_t sectionSize) {
+    if (sectionSize <= m_SectionSize) {
+        return;
+    }
+
+    Release();
+    m_Buffer = GLBuffer{};
+    m_SectionSize = std::bit_ceil(std::max<size_t>(sectionSize, 1UZ << 16UZ));
+    m_Section = 0;
+
+    constexpr GLbitfield flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const auto totalSize =
+        static_cast<GLsizeiptr>(m_SectionSize * SectionCount);
+
+    GL_DEBUG(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_Buffer.ID()));
+    GL_DEBUG(
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, totalSize, nullptr, flags));
+    GL_DEBUG(m_Mapped = static_cast<uint8_t*>(glMapBufferRange(
+                 GL_PIXEL_UNPACK_BUFFER, 0, totalSize, flags)));
+    GL_DEBUG(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+    if (!m_Mapped) {
+        m_MapFailed = true;
+        m_SectionSize = 0;
+    }
+}
+
+void PixelUploadRing::UploadFromClient(std::span<const uint8_t> pixels,
+                                       Size2 size) {
+    GL_DEBUG(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.Width, size.Height,
+                             GL_RED_INTEGER, GL_UNSIGNED_BYTE, pixels.data()));
+}
+
+void PixelUploadRing::WaitForSection(size_t section) {
+    auto& fence = m_Fences[section];
+    if (!fence) {
+        return;
+    }
+
+    constexpr GLuint64 timeout = 1'000'000'000;
+    GL_DEBUG(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout));
+    GL_DEBUG(glDeleteSync(fence));
+    fence = nullptr;
+}
+
+void PixelUploadRing::Release() {
+    for (auto section = 0UZ; section < SectionCount; ++section) {
+        WaitForSection(section);
+    }
+
+    if (m_Mapped) {
+        GL_DEBUG(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_Buffer.ID()));
+        GL_DEBUG(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+        GL_DEBUG(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+        m_Mapped = nullptr;
+    }
+    m_SectionSize = 0;
+}
+} // namespace gol
@@ -106,6 +106,9 @@ concept ActionType =
     std::same_as<T, SelectionAction>;
 
 enum class EditorMode { None, Insert, Delete, Select };
+
+// How simulations are run in editors other than the focused one.
+enum class BackgroundPolicy { Run, Throttle, Pause };
 } // namespace gol
 
 #endif
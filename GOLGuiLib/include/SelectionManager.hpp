@@ -74,7 +74,7 @@ class SelectionManager {
 
     bool GridAlive() const;
     const HashQuadtree& GridData() const;
-    const BigInt& SelectedPopulation() const;
+    BigInt SelectedPopulation() const;
     std::optional<std::string_view> SelectionRuleString() const;
     void SetSelectionRule(std::string_view ruleString);
 
@@ -6,6 +6,7 @@
 #include <variant>
 #include <vector>
 
+#include "BigInt.hpp"
 #include "GameEnums.hpp"
 #include "Graphics2D.hpp"
 
@@ -25,6 +26,9 @@ struct RestartCommand {};
 struct ResetCommand {};
 struct ClearCommand {};
 struct StepCommand {};
+struct RewindCommand {
+    BigInt Generation;
+};
 
 // Editor commands
 struct GenerateNoiseCommand {
@@ -79,11 +83,12 @@ struct PaintStrokeCommand {
 
 using SimulationCommand =
     std::variant<StartCommand, PauseCommand, ResumeCommand, RestartCommand,
-                 ResetCommand, ClearCommand, StepCommand, GenerateNoiseCommand,
-                 UndoCommand, RedoCommand, SaveCommand, SaveAsNewCommand,
-                 NewFileCommand, LoadCommand, CloseCommand, SelectionCommand,
-                 SelectionBoundsCommand, CameraPositionCommand,
-                 CameraZoomCommand, RuleCommand, PaintStrokeCommand>;
+                 ResetCommand, ClearCommand, StepCommand, RewindCommand,
+                 GenerateNoiseCommand, UndoCommand, RedoCommand, SaveCommand,
+                 SaveAsNewCommand, NewFileCommand, LoadCommand, CloseCommand,
+                 SelectionCommand, SelectionBoundsCommand,
+                 CameraPositionCommand, CameraZoomCommand, RuleCommand,
+                 PaintStrokeCommand>;
 
 // Convert individual action enum values to SimulationCommand.
 // Used by Widget::UpdateResult for simple (no-payload) buttons.
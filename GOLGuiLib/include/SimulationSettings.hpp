@@ -3,6 +3,7 @@
 
 #include <cstdint>
 
+#include "GameEnums.hpp"
 #include "LifeAlgorithm.hpp"
 
 namespace gol {
@@ -12,7 +13,15 @@ struct SimulationSettings {
     std::unique_ptr<LifeAlgorithm> Algorithm = nullptr;
     int32_t TickDelayMs = 1;
     bool HyperSpeed = false;
+    // Whether runs size their steps to the frame budget instead of using
+    // StepCount.
+    bool AutoStep = false;
+    // The fewest generations between two timeline checkpoints.
+    int64_t TimelineInterval = 1;
     bool GridLines = false;
+    // Whether newly opened editors store their nodes in the shared cache.
+    bool ShareNodes = false;
+    BackgroundPolicy Background = BackgroundPolicy::Throttle;
 };
 
 } // namespace gol
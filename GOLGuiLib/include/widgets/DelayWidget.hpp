@@ -22,10 +22,14 @@ class DelayWidget : public Widget {
   public:
     int32_t TickDelayMs() const { return m_TickDelayMs; }
     bool ShowGridLines() const { return m_GridLines; }
+    bool ShareNodes() const { return m_ShareNodes; }
+    BackgroundPolicy Background() const { return m_Background; }
 
   private:
     int32_t m_TickDelayMs = 1;
     bool m_GridLines = false;
+    bool m_ShareNodes = false;
+    BackgroundPolicy m_Background = BackgroundPolicy::Throttle;
 };
 } // namespace gol
 
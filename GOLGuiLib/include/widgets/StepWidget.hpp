@@ -52,12 +52,14 @@ class StepWidget : public Widget {
     }
     std::unique_ptr<LifeAlgorithm> CurrentAlgorithm() const { return nullptr; }
     bool IsHyperSpeed() const { return m_HyperSpeed; }
+    bool IsAutoStep() const { return m_AutoStep; }
 
   private:
     std::string m_InputText;
 
     BigInt m_StepCount = 1;
     bool m_HyperSpeed = false;
+    bool m_AutoStep = false;
 
     StepButton m_Button;
 };
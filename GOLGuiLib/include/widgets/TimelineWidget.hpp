@@ -0,0 +1,37 @@
+#ifndef TimelineWidget_hpp_
+#define TimelineWidget_hpp_
+
+#include <cstdint>
+#include <imgui.h>
+#include <span>
+#include <string>
+
+#include "BigInt.hpp"
+#include "EditorResult.hpp"
+#include "GameEnums.hpp"
+#include "Widget.hpp"
+#include "WidgetResult.hpp"
+
+namespace gol {
+// Jumps a paused simulation back to an earlier generation, recomputed from
+// the checkpoints recorded while it ran.
+class TimelineWidget : public Widget {
+  public:
+    TimelineWidget(std::span<const ImGuiKeyChord> = {}) {}
+    friend Widget;
+
+  private:
+    WidgetResult UpdateImpl(const EditorResult& state);
+    void SetShortcutsImpl(const ShortcutMap&) {}
+
+  public:
+    int64_t CheckpointInterval() const { return m_CheckpointInterval; }
+
+  private:
+    std::string m_InputText = "0";
+    BigInt m_Generation{};
+    int64_t m_CheckpointInterval = 1;
+};
+} // namespace gol
+
+#endif
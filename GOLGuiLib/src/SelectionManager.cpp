@@ -194,7 +194,7 @@ std::optional<VersionState> SelectionManager::Delete(const GameGrid& grid) {
 
 std::optional<VersionState> SelectionManager::Rotate(bool clockwise,
                                                      const GameGrid& grid) {
-    if (!m_Selected || !m_Selected->ShouldValidateCache())
+    if (!m_Selected)
         return std::nullopt;
 
     auto upperLeft = SelectionBounds().UpperLeft();
@@ -216,7 +216,7 @@ std::optional<VersionState> SelectionManager::Rotate(bool clockwise,
 
 std::optional<VersionState> SelectionManager::Flip(SelectionAction direction,
                                                    const GameGrid& grid) {
-    if (!m_Selected || !m_Selected->ShouldValidateCache())
+    if (!m_Selected)
         return std::nullopt;
 
     m_Selected->FlipGrid(direction == SelectionAction::FlipVertically);
@@ -397,7 +397,7 @@ VersionState SelectionManager::CaptureState(const GameGrid& grid) const {
     return state;
 }
 
-const BigInt& SelectionManager::SelectedPopulation() const {
+BigInt SelectionManager::SelectedPopulation() const {
     return m_Selected ? m_Selected->Population() : BigZero;
 }
 
@@ -413,12 +413,11 @@ void SelectionManager::SetSelectionRule(std::string_view ruleString) {
         return;
     }
 
-    const auto rule = LifeRule::Make(ruleString);
-    if (!rule) {
+    if (!GameGrid::IsValidRule(ruleString)) {
         return;
     }
 
-    m_Selected->SetRule(*rule, ruleString);
+    m_Selected->SetRule(ruleString);
 }
 
 bool SelectionManager::CanDrawSelection() const {
@@ -15,6 +15,7 @@
 #include "GameGrid.hpp"
 #include "Graphics2D.hpp"
 #include "LifeRule.hpp"
+#include "Tracing.hpp"
 
 namespace gol::FileEncoder {
 static std::string EncodeRLE(const GameGrid& grid, Rect region, Vec2 offset) {
@@ -352,7 +353,7 @@ DecodeRLE(std::string_view src, uint32_t warnThreshold) {
         }
     }
 
-    if (const auto validRule = LifeRule::IsValidRule(ruleString); !validRule) {
+    if (const auto validRule = GameGrid::IsValidRule(ruleString); !validRule) {
         return std::unexpected{
             DecodeError{.ErrorType = DecodeError::Type::InvalidRule,
                         .Message = std::format("Invalid rule '{}': {}",
@@ -458,7 +459,7 @@ DecodeRLE(std::string_view src, uint32_t warnThreshold) {
 
     const auto offset = hasExplicitOffset ? explicitOffset : Vec2{0, 0};
 
-    result.SetRule(*LifeRule::Make(ruleString), ruleString);
+    result.SetRule(ruleString);
     return DecodeResult{std::move(result), offset};
 }
 
@@ -704,6 +705,7 @@ DecodeMacrocell(std::string_view fileContents) {
 std::expected<DecodeResult, DecodeError> DecodeRegion(std::string_view src,
                                                       uint32_t warnThreshold,
                                                       FileFormat fileFormat) {
+    GOL_TRACE_ZONE("FileEncoder::DecodeRegion");
     switch (fileFormat) {
     case FileFormat::RLE:
         return DecodeRLE(src, warnThreshold);
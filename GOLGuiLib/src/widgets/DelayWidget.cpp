@@ -20,6 +20,17 @@ WidgetResult DelayWidget::UpdateImpl(const EditorResult&) {
 
     ImGui::PushStyleVarY(ImGuiStyleVar_ItemSpacing, ImGui::GetFontSize());
     ImGui::Checkbox("Show Grid Lines", &m_GridLines);
+    ImGui::Checkbox("Share Nodes Between Tabs", &m_ShareNodes);
+    ImGui::SetItemTooltip(
+        "Tabs opened from now on store their patterns together, so identical "
+        "content and its results are kept only once.");
+
+    ImGui::Text("Background Tabs");
+    ImGui::SetItemTooltip(
+        "How simulations run in tabs other than the focused one.");
+    auto background = static_cast<int>(m_Background);
+    ImGui::Combo("##Background Tabs", &background, "Run\0Throttle\0Pause\0");
+    m_Background = static_cast<BackgroundPolicy>(background);
 
     ImGui::Separator();
     ImGui::PopStyleVar();
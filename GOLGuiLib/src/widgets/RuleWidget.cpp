@@ -1,5 +1,7 @@
 #include "RuleWidget.hpp"
 #include "DisabledScope.hpp"
+#include "GameGrid.hpp"
+#include "LargerThanLifeRule.hpp"
 #include "LifeRule.hpp"
 
 #include <imgui.h>
@@ -19,7 +21,7 @@ RuleWidget::RuleInfoChange RuleWidget::ResizeComponent(const EditorResult&) {
     ImGui::SetNextItemWidth(totalWidth);
 
     const auto dimensions =
-        LifeRule::ExtractDimensions(m_InputText).value_or(Size2{});
+        GameGrid::ExtractDimensions(m_InputText).value_or(Size2{});
     std::array wrapper{dimensions.Width, dimensions.Height};
     ImGui::InputInt2("##BoundsLabel", wrapper.data());
     ImGui::SetItemTooltip("If a dimension is set to 0, the universe will "
@@ -28,9 +30,13 @@ RuleWidget::RuleInfoChange RuleWidget::ResizeComponent(const EditorResult&) {
     ImGui::SameLine();
 
     const auto newActiveTopology = [&] -> std::optional<TopologyKind> {
-        const auto dimensions = LifeRule::ExtractDimensions(m_InputText);
+        const auto dimensions = GameGrid::ExtractDimensions(m_InputText);
+        // Larger than Life rules only support planes.
+        const bool largerThanLife =
+            LargerThanLifeRule::IsLargerThanLifeRule(m_InputText);
         DisabledScope disableIf{
-            !dimensions || (dimensions->Width == 0 && dimensions->Height == 0)};
+            largerThanLife || !dimensions ||
+            (dimensions->Width == 0 && dimensions->Height == 0)};
 
         const auto oldActiveIndex = m_TopologyCombo.ActiveIndex;
         m_TopologyCombo.ActiveIndex =
@@ -48,7 +54,7 @@ RuleWidget::RuleInfoChange RuleWidget::ResizeComponent(const EditorResult&) {
                                   "re-enter on the opposite side they exited.");
         }
 
-        if (oldActiveIndex != m_TopologyCombo.ActiveIndex) {
+        if (!largerThanLife && oldActiveIndex != m_TopologyCombo.ActiveIndex) {
             return static_cast<TopologyKind>(m_TopologyCombo.ActiveIndex);
         }
         return std::nullopt;
@@ -101,9 +107,11 @@ WidgetResult RuleWidget::UpdateImpl(const EditorResult& state) {
         "digits after 'S'\n"
         "specify the number of neighbors a cell can have to survive to the "
         "next generation.\n"
-        "Conway's Game of Life is therefore defined as B3/S23. Additional "
-        "properties"
-        " can\nbe modified below.");
+        "Conway's Game of Life is therefore defined as B3/S23.\n"
+        "Larger than Life rules such as \"R5,C0,M1,S34..58,B34..45,NM\" "
+        "are also accepted, where R is\nthe neighborhood range, M is whether "
+        "a cell counts itself, and S and B are neighbor\ncount ranges. "
+        "Additional properties can be modified below.");
 
     ImGui::SameLine();
 
@@ -170,7 +178,7 @@ WidgetResult RuleWidget::UpdateImpl(const EditorResult& state) {
         return {};
     }
 
-    const auto validRule = LifeRule::IsValidRule(m_InputText);
+    const auto validRule = GameGrid::IsValidRule(m_InputText);
     if (!validRule) {
         m_InputError.Message = validRule.error();
         m_InputError.Activate();
@@ -141,7 +141,9 @@ WidgetResult StepWidget::UpdateImpl(const EditorResult& state) {
             state.Simulation.State == SimulationState::Simulation;
         DisabledScope disableIf(hideHyperSpeedOption);
 
-        ImGui::Checkbox("Enable Hyper Speed", &m_HyperSpeed);
+        if (ImGui::Checkbox("Enable Hyper Speed", &m_HyperSpeed) &&
+            m_HyperSpeed)
+            m_AutoStep = false;
         ImGui::SetItemTooltip(
             "Hyper Speed enables the HashLife algorithm to "
             "progress as fast as possible. However, this means\n"
@@ -149,6 +151,15 @@ WidgetResult StepWidget::UpdateImpl(const EditorResult& state) {
             "count will be ignored. Expect the simulation\n"
             "to run slowly for the first few jumps, but speed up "
             "significantly afterwards.");
+
+        if (ImGui::Checkbox("Auto Step", &m_AutoStep) && m_AutoStep)
+            m_HyperSpeed = false;
+        ImGui::SetItemTooltip(
+            "Auto Step picks the largest power-of-two step that keeps the "
+            "simulation at a steady\n"
+            "frame rate, and backs off when the pattern starts growing "
+            "quickly. The step count\n"
+            "is still used by the step button.");
     }
     ImGui::Separator();
     ImGui::PopStyleVar();
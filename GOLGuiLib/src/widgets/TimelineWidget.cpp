@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <imgui.h>
+#include <imgui_stdlib.h>
+#include <string>
+
+#include "DisabledScope.hpp"
+#include "GameEnums.hpp"
+#include "SimulationCommand.hpp"
+#include "TimelineWidget.hpp"
+#include "WidgetResult.hpp"
+
+namespace gol {
+
+WidgetResult TimelineWidget::UpdateImpl(const EditorResult& state) {
+    ImGui::PushStyleVarY(ImGuiStyleVar_FramePadding,
+                         Widget::DefaultInputPadding());
+
+    ImGui::Text("Rewind To Generation");
+    ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
+    if (ImGui::InputText("##generation", &m_InputText,
+                         ImGuiInputTextFlags_CharsDecimal)) {
+        try {
+            m_Generation.assign(m_InputText);
+        } catch (const std::exception&) {
+            m_Generation = BigZero;
+        }
+    }
+    ImGui::SetItemTooltip(
+        "Generations are recomputed from the nearest checkpoint recorded\n"
+        "while the simulation ran, so rewinding is quick even for long runs.");
+
+    bool rewind = false;
+    {
+        DisabledScope disableIf{state.Simulation.State !=
+                                SimulationState::Paused};
+        rewind = ImGui::Button("Rewind", {ImGui::GetContentRegionAvail().x,
+                                          ActionButton<GameAction, false>::
+                                              DefaultButtonHeight()});
+    }
+
+    ImGui::Text("Checkpoint Every");
+    ImGui::SetItemTooltip(
+        "The fewest generations between two checkpoints. Long runs space\n"
+        "their checkpoints further apart to keep memory use bounded.");
+    ImGui::PushStyleVarY(ImGuiStyleVar_ItemSpacing, ImGui::GetFontSize());
+    constexpr static int64_t smallStep = 1;
+    constexpr static int64_t bigStep = 100;
+    ImGui::InputScalar("##checkpoint", ImGuiDataType_S64,
+                       &m_CheckpointInterval, &smallStep, &bigStep);
+    m_CheckpointInterval = std::max(m_CheckpointInterval, int64_t{1});
+    ImGui::PopItemWidth();
+
+    ImGui::Separator();
+    ImGui::PopStyleVar(2);
+
+    if (rewind)
+        return {.Command = RewindCommand{.Generation = m_Generation}};
+    return {};
+}
+
+} // namespace gol
@@ -0,0 +1,127 @@
+#ifndef Profiler_hpp_
+#define Profiler_hpp_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace gol {
+enum class ProfileMetric {
+    FrameTime,
+    DrawGrid,
+    Rasterize,
+    Upload,
+    WorkerUpdate,
+    HashLifeStep,
+    Generations,
+    NodesCreated,
+    CacheMemory,
+};
+
+// How a metric's measurements become one sample per frame.
+enum class ProfileMetricKind {
+    // Milliseconds per call, averaged over the calls made during the frame.
+    // Frames without calls repeat the previous sample.
+    CallTime,
+    // Milliseconds spent during the frame, summed over every call.
+    FrameTime,
+    // Counted amounts per second.
+    Rate,
+    // The most recently reported value, in mebibytes.
+    Memory,
+};
+
+struct ProfileMetricInfo {
+    std::string_view Name;
+    ProfileMetricKind Kind;
+};
+
+// Collects timings and counters from any thread and turns them into rolling
+// histories, one sample per UI frame. Recording only touches two atomics, so
+// timers can stay in release builds.
+class Profiler {
+  public:
+    constexpr static size_t HistoryLength = 240;
+    constexpr static size_t MetricCount =
+        static_cast<size_t>(ProfileMetric::CacheMemory) + 1;
+
+    constexpr static std::array<ProfileMetricInfo, MetricCount> Metrics{{
+        {"Frame", ProfileMetricKind::FrameTime},
+        {"Draw Grid", ProfileMetricKind::FrameTime},
+        {"Rasterize", ProfileMetricKind::CallTime},
+        {"Upload", ProfileMetricKind::FrameTime},
+        {"Worker Update", ProfileMetricKind::CallTime},
+        {"HashLife Step", ProfileMetricKind::CallTime},
+        {"Generations", ProfileMetricKind::Rate},
+        {"Nodes Created", ProfileMetricKind::Rate},
+        {"Cache Memory", ProfileMetricKind::Memory},
+    }};
+
+    static Profiler& Get();
+
+    Profiler(const Profiler&) = delete;
+    auto& operator=(const Profiler&) = delete;
+
+    // Records one timed call. Safe to call from any thread.
+    void AddTime(ProfileMetric metric,
+                 std::chrono::steady_clock::duration elapsed);
+
+    // Adds to a rate. Safe to call from any thread.
+    void AddCount(ProfileMetric metric, uint64_t amount);
+
+    // Replaces a memory reading, in bytes. Safe to call from any thread.
+    void SetBytes(ProfileMetric metric, uint64_t bytes);
+
+    // Ends the current frame, appending a sample to every history. The frame
+    // time is the time since the previous call. Only the UI thread may call
+    // this or read the histories.
+    void Sample();
+
+    // The samples of `metric`, oldest first when read starting at
+    // HistoryOffset() and wrapping around.
+    std::span<const float> History(ProfileMetric metric) const;
+    size_t HistoryOffset() const { return m_Next; }
+
+    // The most recent sample of `metric`.
+    float Latest(ProfileMetric metric) const;
+
+  private:
+    Profiler() = default;
+
+    struct Accumulator {
+        std::atomic<uint64_t> Total{};
+        std::atomic<uint64_t> Count{};
+    };
+
+    std::array<Accumulator, MetricCount> m_Accumulators{};
+    std::array<std::array<float, HistoryLength>, MetricCount> m_History{};
+    size_t m_Next = 0;
+    std::chrono::steady_clock::time_point m_LastSample =
+        std::chrono::steady_clock::now();
+};
+
+// Reports the time between its construction and destruction to the profiler.
+class ScopedTimer {
+  public:
+    explicit ScopedTimer(ProfileMetric metric)
+        : m_Metric(metric), m_Start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        Profiler::Get().AddTime(m_Metric,
+                                std::chrono::steady_clock::now() - m_Start);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    auto& operator=(const ScopedTimer&) = delete;
+
+  private:
+    ProfileMetric m_Metric;
+    std::chrono::steady_clock::time_point m_Start;
+};
+} // namespace gol
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef Tracing_hpp_
+#define Tracing_hpp_
+
+// Named trace zones for timelines of whole sessions. The GOL_TRACING CMake
+// option selects where they go: nowhere (OFF, the default, where the macros
+// compile to nothing), a Chrome trace-event file written when the program
+// exits (CHROME, loadable in chrome://tracing or Perfetto), or a connected
+// Tracy profiler (TRACY).
+//
+// GOL_TRACE_ZONE(name) traces the rest of the enclosing scope.
+// GOL_TRACE_ZONE_IF(name, active) does so only when `active` is true, for
+// recursive functions whose deeper calls would drown out the timeline.
+// `name` must be a string literal.
+
+#define GOL_TRACE_CONCAT_IMPL(a, b) a##b
+#define GOL_TRACE_CONCAT(a, b) GOL_TRACE_CONCAT_IMPL(a, b)
+
+#if defined(GOL_TRACE_TRACY)
+
+#include <tracy/Tracy.hpp>
+
+#define GOL_TRACE_ZONE(name) ZoneScopedN(name)
+#define GOL_TRACE_ZONE_IF(name, active)                                        \
+    ZoneNamedN(GOL_TRACE_CONCAT(golTraceZone, __LINE__), name, active)
+
+#elif defined(GOL_TRACE_CHROME)
+
+#include <chrono>
+
+namespace gol {
+// Records the time between its construction and destruction as a complete
+// event on the current thread's track.
+class TraceZone {
+  public:
+    explicit TraceZone(const char* name, bool active = true)
+        : m_Name(active ? name : nullptr),
+          m_Start(std::chrono::steady_clock::now()) {}
+
+    ~TraceZone();
+
+    TraceZone(const TraceZone&) = delete;
+    auto& operator=(const TraceZone&) = delete;
+
+  private:
+    const char* m_Name;
+    std::chrono::steady_clock::time_point m_Start;
+};
+} // namespace gol
+
+#define GOL_TRACE_ZONE(name)                                                   \
+    gol::TraceZone GOL_TRACE_CONCAT(golTraceZone, __LINE__) { name }
+#define GOL_TRACE_ZONE_IF(name, active)                                        \
+    gol::TraceZone GOL_TRACE_CONCAT(golTraceZone, __LINE__) { name, active }
+
+#else
+
+#define GOL_TRACE_ZONE(name)
+#define GOL_TRACE_ZONE_IF(name, active)
+
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "Profiler.hpp"
+
+namespace gol {
+Profiler& Profiler::Get() {
+    static Profiler profiler{};
+    return profiler;
+}
+
+void Profiler::AddTime(ProfileMetric metric,
+                       std::chrono::steady_clock::duration elapsed) {
+    auto& accumulator = m_Accumulators[static_cast<size_t>(metric)];
+    const auto nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    accumulator.Total.fetch_add(static_cast<uint64_t>(nanoseconds),
+                                std::memory_order_relaxed);
+    accumulator.Count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::AddCount(ProfileMetric metric, uint64_t amount) {
+    m_Accumulators[static_cast<size_t>(metric)].Total.fetch_add(
+        amount, std::memory_order_relaxed);
+}
+
+void Profiler::SetBytes(ProfileMetric metric, uint64_t bytes) {
+    m_Accumulators[static_cast<size_t>(metric)].Total.store(
+        bytes, std::memory_order_relaxed);
+}
+
+void Profiler::Sample() {
+    const auto now = std::chrono::steady_clock::now();
+    const auto frameTime =
+        std::chrono::duration<double, std::milli>(now - m_LastSample).count();
+    m_LastSample = now;
+
+    const auto previous = (m_Next + HistoryLength - 1) % HistoryLength;
+    for (auto i = 0UZ; i < MetricCount; ++i) {
+        auto& accumulator = m_Accumulators[i];
+        auto& history = m_History[i];
+
+        if (static_cast<ProfileMetric>(i) == ProfileMetric::FrameTime) {
+            history[m_Next] = static_cast<float>(frameTime);
+            continue;
+        }
+
+        switch (Metrics[i].Kind) {
+        case ProfileMetricKind::CallTime: {
+            const auto total =
+                accumulator.Total.exchange(0, std::memory_order_relaxed);
+            const auto count =
+                accumulator.Count.exchange(0, std::memory_order_relaxed);
+            history[m_Next] =
+                count == 0 ? history[previous]
+                           : static_cast<float>(static_cast<double>(total) /
+                                                static_cast<double>(count) /
+                                                1e6);
+            break;
+        }
+        case ProfileMetricKind::FrameTime:
+            accumulator.Count.store(0, std::memory_order_relaxed);
+            history[m_Next] = static_cast<float>(
+                static_cast<double>(accumulator.Total.exchange(
+                    0, std::memory_order_relaxed)) /
+                1e6);
+            break;
+        case ProfileMetricKind::Rate:
+            history[m_Next] =
+                frameTime <= 0.0
+                    ? history[previous]
+                    : static_cast<float>(
+                          static_cast<double>(accumulator.Total.exchange(
+                              0, std::memory_order_relaxed)) /
+                          (frameTime / 1e3));
+            break;
+        case ProfileMetricKind::Memory:
+            history[m_Next] = static_cast<float>(
+                static_cast<double>(
+                    accumulator.Total.load(std::memory_order_relaxed)) /
+                (1024.0 * 1024.0));
+            break;
+        }
+    }
+
+    m_Next = (m_Next + 1) % HistoryLength;
+}
+
+std::span<const float> Profiler::History(ProfileMetric metric) const {
+    return m_History[static_cast<size_t>(metric)];
+}
+
+float Profiler::Latest(ProfileMetric metric) const {
+    return m_History[static_cast<size_t>(metric)]
+                    [(m_Next + HistoryLength - 1) % HistoryLength];
+}
+} // namespace gol
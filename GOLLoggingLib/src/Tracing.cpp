@@ -0,0 +1,118 @@
+#include "Tracing.hpp"
+
+#ifdef GOL_TRACE_CHROME
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <print>
+#include <vector>
+
+namespace gol {
+namespace {
+// Timestamps count from program start, before any zone can open.
+const auto TraceEpoch = std::chrono::steady_clock::now();
+
+// Collects the events of every thread and writes them out as Chrome
+// trace-event JSON when the program exits.
+class TraceRecorder {
+  public:
+    // Events kept per thread, so that a long session cannot exhaust memory.
+    constexpr static size_t MaxEventsPerThread = 1UZ << 22UZ;
+
+    static TraceRecorder& Get() {
+        static TraceRecorder recorder{};
+        return recorder;
+    }
+
+    ~TraceRecorder() { Write("gol_trace.json"); }
+
+    void Record(const char* name, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end) {
+        auto& buffer = CurrentBuffer();
+        std::scoped_lock lock{buffer.Mutex};
+        if (buffer.Events.size() >= MaxEventsPerThread) {
+            ++buffer.Dropped;
+            return;
+        }
+        buffer.Events.push_back({name, Microseconds(start - TraceEpoch),
+                                 Microseconds(end - start)});
+    }
+
+  private:
+    struct Event {
+        const char* Name;
+        int64_t Start;
+        int64_t Duration;
+    };
+
+    // Each thread only locks its own buffer, so recording never contends
+    // with other threads.
+    struct ThreadBuffer {
+        std::mutex Mutex;
+        size_t ThreadIndex = 0;
+        std::vector<Event> Events;
+        size_t Dropped = 0;
+    };
+
+    static int64_t Microseconds(std::chrono::steady_clock::duration time) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time)
+            .count();
+    }
+
+    ThreadBuffer& CurrentBuffer() {
+        // Buffers are shared with the recorder, so events outlive threads.
+        thread_local const auto buffer = [&] {
+            auto created = std::make_shared<ThreadBuffer>();
+            std::scoped_lock lock{m_Mutex};
+            created->ThreadIndex = m_Buffers.size();
+            m_Buffers.push_back(created);
+            return created;
+        }();
+        return *buffer;
+    }
+
+    void Write(const char* path) {
+        std::ofstream out{path};
+        if (!out.is_open()) {
+            return;
+        }
+
+        std::scoped_lock lock{m_Mutex};
+        std::print(out, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+        auto first = true;
+        for (const auto& buffer : m_Buffers) {
+            std::scoped_lock bufferLock{buffer->Mutex};
+            for (const auto& event : buffer->Events) {
+                std::print(out,
+                           "{}\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,"
+                           "\"tid\":{},\"ts\":{},\"dur\":{}}}",
+                           first ? "" : ",", event.Name, buffer->ThreadIndex,
+                           event.Start, event.Duration);
+                first = false;
+            }
+            if (buffer->Dropped > 0) {
+                std::println("[WARNING] Dropped {} trace events on thread {}",
+                             buffer->Dropped, buffer->ThreadIndex);
+            }
+        }
+        std::print(out, "\n]}}\n");
+    }
+
+    std::mutex m_Mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_Buffers;
+};
+} // namespace
+
+TraceZone::~TraceZone() {
+    if (m_Name != nullptr) {
+        TraceRecorder::Get().Record(m_Name, m_Start,
+                                    std::chrono::steady_clock::now());
+    }
+}
+} // namespace gol
+
+#endif
@@ -0,0 +1,58 @@
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include "AdaptiveStepController.hpp"
+
+namespace gol {
+
+using namespace std::chrono_literals;
+
+TEST(AdaptiveStepControllerTest, GrowsWhileUpdatesAreFast) {
+    AdaptiveStepController controller{16ms};
+    EXPECT_EQ(controller.StepCount(), 1);
+
+    for (auto i = 0; i < 5; ++i)
+        controller.Record(1ms, 0, 0);
+    EXPECT_EQ(controller.Log2StepCount(), 5);
+    EXPECT_EQ(controller.StepCount(), 32);
+
+    // Updates within the budget keep the step where it is.
+    controller.Record(12ms, 0, 0);
+    EXPECT_EQ(controller.Log2StepCount(), 5);
+}
+
+TEST(AdaptiveStepControllerTest, ShrinksByTheOvershoot) {
+    AdaptiveStepController controller{16ms};
+    for (auto i = 0; i < 10; ++i)
+        controller.Record(1ms, 0, 0);
+
+    controller.Record(20ms, 0, 0);
+    EXPECT_EQ(controller.Log2StepCount(), 9);
+
+    controller.Record(100ms, 0, 0);
+    EXPECT_EQ(controller.Log2StepCount(), 6);
+
+    controller.Record(10s, 0, 0);
+    EXPECT_EQ(controller.Log2StepCount(), 0);
+}
+
+TEST(AdaptiveStepControllerTest, BacksOffOnCacheSpikes) {
+    AdaptiveStepController controller{16ms};
+    for (auto i = 0; i < 4; ++i)
+        controller.Record(1ms, 0, 0);
+
+    constexpr auto cacheBytes = 1UZ << 30;
+    controller.Record(1ms, cacheBytes, cacheBytes + cacheBytes / 2);
+    EXPECT_EQ(controller.Log2StepCount(), 3);
+
+    // Growth is held off for a while after backing off.
+    for (auto i = 0; i < AdaptiveStepController::GrowCooldown; ++i)
+        controller.Record(1ms, cacheBytes, cacheBytes);
+    EXPECT_EQ(controller.Log2StepCount(), 3);
+    controller.Record(1ms, cacheBytes, cacheBytes);
+    EXPECT_EQ(controller.Log2StepCount(), 4);
+
+    controller.Reset();
+    EXPECT_EQ(controller.StepCount(), 1);
+}
+} // namespace gol
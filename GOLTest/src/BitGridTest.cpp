@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "BitGrid.hpp"
+#include "HashLife.hpp"
+#include "HashQuadtree.hpp"
+#include "LargerThanLife.hpp"
+#include "LargerThanLifeRule.hpp"
+#include "Torus.hpp"
+
+namespace gol {
+// Returns the live cells of `tree` in sorted order.
+static std::vector<Vec2> CellsOf(const HashQuadtree& tree) {
+    std::vector<Vec2> cells{};
+    for (const auto cell : tree)
+        cells.push_back(cell);
+    std::ranges::sort(cells);
+    return cells;
+}
+
+TEST(BitGridTest, FitsOnlyFullyBoundedUniverses) {
+    EXPECT_TRUE(BitGrid::Fits({64, 64}));
+    EXPECT_FALSE(BitGrid::Fits({0, 64}));
+    EXPECT_FALSE(BitGrid::Fits({64, 0}));
+    EXPECT_FALSE(BitGrid::Fits({1 << 15, 1 << 15}));
+}
+
+TEST(BitGridTest, PrefersSmallOrDenseUniverses) {
+    EXPECT_TRUE(BitGrid::Prefers({64, 64}, 0));
+
+    // A large universe is only worth sweeping while it is dense enough.
+    const Size2 large{1 << 13, 1 << 13};
+    EXPECT_FALSE(BitGrid::Prefers(large, 5));
+    EXPECT_TRUE(BitGrid::Prefers(large, BigInt{1} << 18));
+
+    EXPECT_FALSE(BitGrid::Prefers({1 << 15, 1 << 15}, BigInt{1} << 28));
+}
+
+TEST(BitGridTest, BlinkerOscillates) {
+    const auto rule = *LifeRule::Make("B3/S23");
+    BitGrid grid{HashQuadtree{LifeHashSet{{1, 2}, {2, 2}, {3, 2}}},
+                 {5, 5},
+                 false};
+
+    grid.Step(rule);
+    EXPECT_EQ(CellsOf(grid.ToQuadtree()),
+              (std::vector<Vec2>{{2, 1}, {2, 2}, {2, 3}}));
+
+    grid.Step(rule);
+    EXPECT_EQ(CellsOf(grid.ToQuadtree()),
+              (std::vector<Vec2>{{1, 2}, {2, 2}, {3, 2}}));
+}
+
+TEST(BitGridTest, PlaneMatchesLargerThanLife) {
+    // A width of 70 spans two words, so carries between words and the
+    // partially filled last word are both exercised.
+    constexpr Size2 size{70, 30};
+    std::mt19937 generator{7};
+    std::bernoulli_distribution alive{0.35};
+
+    LifeHashSet soup{};
+    for (auto y = 0; y < size.Height; ++y)
+        for (auto x = 0; x < size.Width; ++x)
+            if (alive(generator))
+                soup.insert({x, y});
+
+    const auto rule = *LifeRule::Make("B3/S23");
+    BitGrid grid{HashQuadtree{soup}, size, false};
+
+    LargerThanLife reference{
+        *LargerThanLifeRule::Make("R1,C0,M0,S2..3,B3..3:P70,30")};
+    HashQuadtree expected{soup};
+
+    for (auto generation = 1; generation <= 20; ++generation) {
+        grid.Step(rule);
+        reference.Step(expected, 1);
+        ASSERT_EQ(CellsOf(grid.ToQuadtree()), CellsOf(expected))
+            << "Mismatch at generation " << generation;
+    }
+}
+
+TEST(BitGridTest, HashLifeSteppingWrapsAroundTorus) {
+    HashLife algorithm{std::make_unique<Torus>(Rect{0, 0, 8, 8})};
+    algorithm.SetRule(*LifeRule::Make("B3/S23"));
+
+    // A glider moves one cell diagonally every four generations, so it is
+    // back where it started after 32 on an 8x8 torus. Stepping in two halves
+    // reuses the grid from the first call.
+    const LifeHashSet glider{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    HashQuadtree tree{glider};
+    const auto start = CellsOf(tree);
+
+    EXPECT_EQ(algorithm.Step(tree, 16), 16);
+    EXPECT_NE(CellsOf(tree), start);
+    EXPECT_EQ(algorithm.Step(tree, 16), 16);
+    EXPECT_EQ(CellsOf(tree), start);
+}
+} // namespace gol
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include "ClockCache.hpp"
+
+namespace gol {
+
+TEST(ClockCacheTest, FindReturnsInsertedValues) {
+    ClockCache<int32_t, int32_t> cache{4};
+    cache.Insert(1, 10);
+    cache.Insert(2, 20);
+
+    EXPECT_EQ(cache.Find(1), 10);
+    EXPECT_EQ(cache.Find(2), 20);
+    EXPECT_FALSE(cache.Find(3).has_value());
+
+    EXPECT_EQ(cache.Stats().Hits, 2U);
+    EXPECT_EQ(cache.Stats().Misses, 1U);
+    EXPECT_EQ(cache.Stats().Evictions, 0U);
+}
+
+TEST(ClockCacheTest, NeverExceedsCapacity) {
+    ClockCache<int32_t, int32_t> cache{8};
+    for (auto i = 0; i < 100; ++i)
+        cache.Insert(i, i);
+
+    EXPECT_EQ(cache.size(), 8U);
+    EXPECT_EQ(cache.Stats().Evictions, 92U);
+}
+
+TEST(ClockCacheTest, ReferencedEntriesSurviveEviction) {
+    ClockCache<int32_t, int32_t> cache{3};
+    cache.Insert(1, 1);
+    cache.Insert(2, 2);
+    cache.Insert(3, 3);
+
+    // The hand spares 1 because it was looked up, and evicts 2 instead.
+    EXPECT_TRUE(cache.Find(1).has_value());
+    cache.Insert(4, 4);
+
+    EXPECT_TRUE(cache.Find(1).has_value());
+    EXPECT_FALSE(cache.Find(2).has_value());
+    EXPECT_TRUE(cache.Find(3).has_value());
+    EXPECT_TRUE(cache.Find(4).has_value());
+}
+
+TEST(ClockCacheTest, ShrinkingDiscardsEntries) {
+    ClockCache<int32_t, int32_t> cache{4};
+    cache.Insert(1, 1);
+    cache.Insert(2, 2);
+
+    cache.SetCapacity(1);
+    EXPECT_EQ(cache.size(), 0U);
+
+    cache.SetCapacity(0);
+    cache.Insert(3, 3);
+    EXPECT_FALSE(cache.Find(3).has_value());
+}
+} // namespace gol
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "GameGrid.hpp"
+#include "GenerationTimeline.hpp"
+
+namespace gol {
+namespace {
+// An R-pentomino, which keeps changing for over a thousand generations.
+GameGrid RPentomino() {
+    GameGrid grid{};
+    grid.Set(1, 0, true);
+    grid.Set(2, 0, true);
+    grid.Set(0, 1, true);
+    grid.Set(1, 1, true);
+    grid.Set(1, 2, true);
+    return grid;
+}
+} // namespace
+
+TEST(GenerationTimelineTest, RewindMatchesARunFromTheStart) {
+    auto grid = RPentomino();
+    GenerationTimeline timeline{BigInt{4}};
+    for (auto i = 0; i < 20; ++i) {
+        timeline.Record(grid);
+        grid.Update(1);
+    }
+    EXPECT_EQ(timeline.Size(), 5U);
+
+    auto expected = RPentomino();
+    expected.Update(9);
+
+    const auto rewound = timeline.Rewind(BigInt{9});
+    ASSERT_TRUE(rewound.has_value());
+    EXPECT_EQ(rewound->Generation(), 9);
+    EXPECT_EQ(rewound->Data(), expected.Data());
+
+    ASSERT_NE(timeline.Nearest(BigInt{9}), nullptr);
+    EXPECT_EQ(timeline.Nearest(BigInt{9})->Generation(), 8);
+}
+
+TEST(GenerationTimelineTest, ThinningKeepsTheStartAndDoublesTheSpacing) {
+    auto grid = RPentomino();
+    GenerationTimeline timeline{BigOne, 4};
+    for (auto i = 0; i <= 4; ++i) {
+        timeline.Record(grid);
+        grid.Update(1);
+    }
+
+    EXPECT_EQ(timeline.Size(), 3U);
+    EXPECT_EQ(timeline.Interval(), 2);
+    EXPECT_EQ(timeline.Nearest(BigInt{1})->Generation(), 0);
+    EXPECT_EQ(timeline.Nearest(BigInt{3})->Generation(), 2);
+    EXPECT_EQ(timeline.Nearest(BigInt{4})->Generation(), 4);
+}
+
+TEST(GenerationTimelineTest, BranchDiscardsLaterCheckpoints) {
+    auto grid = RPentomino();
+    GenerationTimeline timeline{};
+    for (auto i = 0; i < 6; ++i) {
+        timeline.Record(grid);
+        grid.Update(1);
+    }
+
+    auto edited = *timeline.Rewind(BigInt{3});
+    edited.Set(10, 10, true);
+    timeline.Branch(edited);
+
+    EXPECT_EQ(timeline.Size(), 4U);
+    EXPECT_EQ(timeline.Nearest(BigInt{5})->Data(), edited.Data());
+    EXPECT_FALSE(GenerationTimeline{}.Rewind(BigOne).has_value());
+}
+} // namespace gol
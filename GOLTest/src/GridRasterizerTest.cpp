@@ -0,0 +1,109 @@
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "GridRasterizer.hpp"
+#include "HashQuadtree.hpp"
+
+namespace gol {
+static RasterWindow MakeWindow(Rect visible, Vec2 offset,
+                               int32_t minLevel = 0) {
+    const auto scale = 1 << minLevel;
+    const auto toCoarse = [&](int32_t cell) {
+        return static_cast<int64_t>(std::floor(static_cast<double>(cell) /
+                                               static_cast<double>(scale)));
+    };
+    const auto minX = toCoarse(visible.X);
+    const auto minY = toCoarse(visible.Y);
+    const auto width = toCoarse(visible.X + visible.Width - 1) - minX + 1;
+    const auto height = toCoarse(visible.Y + visible.Height - 1) - minY + 1;
+
+    RasterWindow window{};
+    window.Blit = {minX,
+                   minY,
+                   static_cast<int32_t>(width),
+                   static_cast<int32_t>(height),
+                   static_cast<float>(scale),
+                   minLevel > 0 ? 8 : 1};
+    window.MinLevel = minLevel;
+    window.Offset = offset;
+    window.MinCellX = visible.X;
+    window.MinCellY = visible.Y;
+    window.MaxCellX = visible.X + visible.Width - 1;
+    window.MaxCellY = visible.Y + visible.Height - 1;
+    window.LocalBounds = {BigInt{visible.X - offset.X},
+                          BigInt{visible.Y - offset.Y},
+                          BigInt{visible.Width}, BigInt{visible.Height}};
+    return window;
+}
+
+static HashQuadtree ScatteredCells() {
+    LifeHashSet cells{};
+    for (auto i = 0; i < 64; ++i)
+        cells.insert({(i * 37) % 61 - 20, (i * 53) % 47 - 15});
+    return HashQuadtree{cells};
+}
+
+TEST(GridRasterizerTest, MarkCellPacksEightTexelsPerByte) {
+    const auto window = MakeWindow({0, 0, 10, 2}, {});
+    std::vector<uint8_t> buffer(window.Blit.PackedSize());
+    ASSERT_EQ(buffer.size(), 4U);
+
+    // Rows are stored top to bottom, leftmost texel in the lowest bit.
+    window.MarkCell(buffer, Vec2{9, 0});
+    window.MarkCell(buffer, Vec2{2, 1});
+    window.MarkCell(buffer, Vec2{10, 1});
+
+    EXPECT_EQ(buffer, (std::vector<uint8_t>{0, 0b10, 0b100, 0}));
+}
+
+TEST(GridRasterizerTest, PackedRegionMatchesCellByCellRasterization) {
+    const auto tree = ScatteredCells();
+
+    // An odd width and offset put 8x8 blocks across byte boundaries.
+    const auto window = MakeWindow({-13, -9, 61, 50}, {5, 3});
+
+    std::vector<uint8_t> expected(window.Blit.PackedSize());
+    for (const auto cell : tree)
+        window.MarkCell(expected, cell);
+
+    GridRasterizer rasterizer{};
+    std::vector<uint8_t> actual{};
+    rasterizer.Rasterize(tree, window, actual);
+
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(GridRasterizerTest, DensityShadeGrowsWithPopulation) {
+    EXPECT_EQ(GridRasterizer::DensityShade(TrueNode, 0), 255);
+
+    const HashQuadtree sparse{LifeHashSet{{0, 0}}};
+    ASSERT_GT(sparse.CalculateDepth(), 0);
+    const auto shade =
+        GridRasterizer::DensityShade(sparse.Data(), sparse.CalculateDepth());
+    EXPECT_GE(shade, GridRasterizer::MinShade);
+    EXPECT_LT(shade, 255);
+}
+
+TEST(GridRasterizerTest, ShadedTilesMatchNodeByNodeRasterization) {
+    const auto tree = ScatteredCells();
+    const Vec2 offset{5, 3};
+    const auto window = MakeWindow({-13, -9, 61, 50}, offset, 1);
+    ASSERT_GT(tree.CalculateDepth(), 1 + GridRasterizer::TileLevels);
+
+    std::vector<uint8_t> expected(window.Blit.PackedSize());
+    const auto markNode = [&](const LifeNode* node, Vec2L pos) {
+        window.MarkTexel(expected, (pos.X + offset.X) >> 1,
+                         (pos.Y + offset.Y) >> 1,
+                         GridRasterizer::DensityShade(node, 1));
+    };
+    tree.ForEachNode(markNode, {-18, -12, 61, 50}, 1);
+
+    GridRasterizer rasterizer{};
+    std::vector<uint8_t> actual{};
+    rasterizer.Rasterize(tree, window, actual);
+
+    EXPECT_EQ(actual, expected);
+}
+} // namespace gol
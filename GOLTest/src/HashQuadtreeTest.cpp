@@ -1,11 +1,18 @@
 #include <algorithm>
+#include <array>
 #include <gtest/gtest.h>
+#include <initializer_list>
+#include <optional>
 
 #include <print>
 #include <random>
 #include <ranges>
+#include <span>
+#include <thread>
+#include <vector>
 
 #include "FileFormatHandler.hpp"
+#include "GameGrid.hpp"
 #include "HashLife.hpp"
 #include "HashQuadtree.hpp"
 #include "LifeAlgorithm.hpp"
@@ -115,6 +122,58 @@ TEST(HashQuadtreeTest, PopulationMatchesLiveCells) {
     EXPECT_EQ(singleTree.Population(), BigZero);
 }
 
+TEST(HashQuadtreeTest, NodePopulationSaturates) {
+    // fullNodes[i] is a completely live node of level i.
+    std::vector<LifeNode> fullNodes{};
+    fullNodes.reserve(34);
+    fullNodes.push_back(StaticTrueNode);
+    for (auto level = 1; level < 34; ++level) {
+        const auto* child = &fullNodes.back();
+        fullNodes.emplace_back(child, child, child, child);
+    }
+
+    EXPECT_EQ(fullNodes[1].Population, 4U);
+    EXPECT_EQ(fullNodes[31].Population, 1ULL << 62U);
+    EXPECT_EQ(fullNodes[32].Population, PopulationOverflow);
+    EXPECT_EQ(fullNodes[33].Population, PopulationOverflow);
+}
+
+TEST(HashQuadtreeTest, RasterizeRegionMatchesGet) {
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int32_t> coord{-40, 40};
+    LifeHashSet cells{};
+    for (auto i = 0; i < 600; ++i)
+        cells.insert({coord(rng), coord(rng)});
+    const HashQuadtree tree{cells};
+
+    // An unaligned region cuts through 8x8 blocks on every side.
+    constexpr static Rect region{-29, -35, 61, 45};
+    const auto stride = static_cast<size_t>((region.Width + 7) / 8);
+    std::vector<uint8_t> buffer(stride * region.Height);
+    tree.RasterizeRegion(region, 0, buffer);
+
+    for (auto y = 0; y < region.Height; ++y) {
+        for (auto x = 0; x < region.Width; ++x) {
+            const auto bit = (buffer[y * stride + x / 8] >> (x % 8)) & 1U;
+            ASSERT_EQ(bit == 1U, tree.Get({region.X + x, region.Y + y}))
+                << x << ", " << y;
+        }
+    }
+}
+
+TEST(HashQuadtreeTest, RasterizeRegionMarksCoarseTexels) {
+    // The tree's corner lies at (0, 0), so its level 2 nodes line up with
+    // the texels.
+    const LifeHashSet cells{{0, 0}, {5, 2}, {9, 12}, {15, 15}};
+    const HashQuadtree tree{cells};
+
+    // Level 2 texels are 4x4 cells, so the region is 4 texels by 4 texels.
+    std::vector<uint8_t> buffer(4);
+    tree.RasterizeRegion({0, 0, 16, 16}, 2, buffer);
+
+    EXPECT_EQ(buffer, (std::vector<uint8_t>{0b11, 0, 0, 0b1100}));
+}
+
 TEST(HashQuadtreeTest, SingleCell) {
     LifeHashSet cells = {{10, 20}};
     HashQuadtree tree{cells};
@@ -267,6 +326,112 @@ TEST(HashQuadtreeTest, AdvanceGlider) {
     EXPECT_FALSE(sameAsStart) << "Glider did not move";
 }
 
+TEST(HashQuadtreeTest, EqualityIgnoresRootsAndOffsets) {
+    const std::initializer_list<Vec2> cells{{1, 0}, {2, 1}, {0, 2}, {1, 2},
+                                            {2, 2}};
+    HashQuadtree built{std::vector<Vec2>{cells}};
+
+    // Grown cell by cell from a far away cell, so its root and offset differ
+    // from those of `built`.
+    HashQuadtree painted{};
+    painted.Set({-37, 11}, true);
+    for (const auto cell : cells)
+        painted.Set(cell, true);
+    EXPECT_NE(built, painted);
+
+    painted.Set({-37, 11}, false);
+    EXPECT_EQ(built, painted);
+
+    painted.Set({2, 2}, false);
+    painted.Set({3, 2}, true);
+    EXPECT_NE(built, painted);
+}
+
+TEST(HashQuadtreeTest, TransformsMoveCellsAboutTheOrigin) {
+    const std::vector<Vec2> cells{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2},
+                                  {-40, 7}};
+    const auto transformed = [&](auto map) {
+        return cells | std::views::transform(map) |
+               std::ranges::to<LifeHashSet>();
+    };
+
+    HashQuadtree tree{cells};
+    tree.Rotate90(true);
+    EXPECT_EQ(tree | std::ranges::to<LifeHashSet>(),
+              transformed([](Vec2 v) { return Vec2{-1 - v.Y, v.X}; }));
+
+    tree = HashQuadtree{cells};
+    tree.Rotate90(false);
+    EXPECT_EQ(tree | std::ranges::to<LifeHashSet>(),
+              transformed([](Vec2 v) { return Vec2{v.Y, -1 - v.X}; }));
+
+    tree = HashQuadtree{cells};
+    tree.Flip(true);
+    EXPECT_EQ(tree | std::ranges::to<LifeHashSet>(),
+              transformed([](Vec2 v) { return Vec2{v.X, -1 - v.Y}; }));
+
+    tree = HashQuadtree{cells};
+    tree.Flip(false);
+    EXPECT_EQ(tree | std::ranges::to<LifeHashSet>(),
+              transformed([](Vec2 v) { return Vec2{-1 - v.X, v.Y}; }));
+
+    tree = HashQuadtree{cells};
+    tree.Transpose();
+    tree.Translate({3, -2});
+    EXPECT_EQ(tree | std::ranges::to<LifeHashSet>(),
+              transformed([](Vec2 v) { return Vec2{v.Y + 3, v.X - 2}; }));
+
+    tree = HashQuadtree{cells};
+    for (auto i = 0; i < 4; ++i)
+        tree.Rotate90(true);
+    EXPECT_EQ(tree, HashQuadtree{cells});
+}
+
+TEST(HashQuadtreeTest, GridRotationStaysWithinItsBounds) {
+    GameGrid grid{4, 3};
+    grid.Set(0, 0, true);
+    grid.Set(3, 1, true);
+
+    grid.RotateGrid(true);
+    EXPECT_EQ(grid.Size(), (Size2{3, 4}));
+    EXPECT_EQ(grid.Data() | std::ranges::to<LifeHashSet>(),
+              (LifeHashSet{{2, 0}, {1, 3}}));
+
+    grid.FlipGrid(false);
+    EXPECT_EQ(grid.Data() | std::ranges::to<LifeHashSet>(),
+              (LifeHashSet{{0, 0}, {1, 3}}));
+}
+
+TEST(HashQuadtreeTest, SetManyMatchesSettingEachCell) {
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> coordinate{-300, 300};
+    std::vector<Vec2> cells{};
+    for (auto i = 0; i < 500; ++i)
+        cells.emplace_back(coordinate(generator), coordinate(generator));
+
+    HashQuadtree expected{};
+    for (const auto cell : cells)
+        expected.Set(cell, true);
+
+    HashQuadtree batched{};
+    batched.SetMany(cells, true);
+    EXPECT_EQ(batched, expected);
+
+    // Clearing half of them, including cells that were never set.
+    const std::span<const Vec2> cleared{cells.begin(), cells.size() / 2};
+    for (const auto cell : cleared) {
+        expected.Set(cell, false);
+        expected.Set({cell.X + 1000, cell.Y}, false);
+    }
+    batched.SetMany(cleared, false);
+    batched.SetMany(cleared | std::views::transform([](Vec2 cell) {
+                        return Vec2{cell.X + 1000, cell.Y};
+                    }) | std::ranges::to<std::vector>(),
+                    false);
+    EXPECT_EQ(batched, expected);
+    EXPECT_EQ(batched.Population(), expected.Population());
+}
+
 TEST(HashQuadtreeTest, ConstIteratorUsage) {
     const LifeHashSet cells{{1, 1}, {5, 5}};
     const HashQuadtree tree{cells};
@@ -398,6 +563,114 @@ TEST(HashQuadtreeTest, SlowAdvanceSingleStepDyingPattern) {
         << "All isolated cells should die after one generation";
 }
 
+TEST(HashQuadtreeTest, BirthOnZeroSingleCell) {
+    // Under B0/S, a lone cell turns everything but its 3x3 neighborhood on,
+    // which then collapses back to the original cell.
+    HashLife hashLife{};
+    hashLife.SetRule(*LifeRule::Make("B0/S"));
+
+    const LifeHashSet cells{{5, 5}};
+    HashQuadtree tree{cells};
+
+    // Odd requests are rounded up to the next even generation.
+    EXPECT_EQ(hashLife.Step(tree, 1), 2);
+    VerifyContent(tree, cells);
+
+    EXPECT_EQ(hashLife.Step(tree, 6), 6);
+    VerifyContent(tree, cells);
+
+    const auto gens = hashLife.Step(tree, 0);
+    EXPECT_EQ(gens % 2, 0);
+    VerifyContent(tree, cells);
+
+    hashLife.SetRule(*LifeRule::Make("B3/S23"));
+}
+
+TEST(HashQuadtreeTest, BirthOnZeroSurviveEightStepsComplement) {
+    // Under B0/S8 the tree holds the dead cells on a live background. A lone
+    // dead cell leaves its neighbors with seven live neighbors, so they die
+    // too, while the cell itself is not born.
+    HashLife hashLife{};
+    hashLife.SetRule(*LifeRule::Make("B0/S8"));
+
+    HashQuadtree tree{LifeHashSet{{5, 5}}};
+
+    // Every generation is stored the same way, so odd steps are not rounded.
+    EXPECT_EQ(hashLife.Step(tree, 1), 1);
+    LifeHashSet expected{};
+    for (auto y = 4; y <= 6; ++y) {
+        for (auto x = 4; x <= 6; ++x) {
+            expected.insert({x, y});
+        }
+    }
+    VerifyContent(tree, expected);
+
+    hashLife.SetRule(*LifeRule::Make("B3/S23"));
+}
+
+TEST(HashQuadtreeTest, RuleSwitchKeepsResultsSeparate) {
+    const LifeHashSet block{{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+    HashLife hashLife{};
+
+    HashQuadtree conway{block};
+    hashLife.Step(conway, 0);
+    VerifyContent(conway, block);
+
+    // Under B2/S the same nodes advance differently, so results cached under
+    // one rule must never be returned for the other.
+    hashLife.SetRule(*LifeRule::Make("B2/S"));
+    HashQuadtree seeds{block};
+    hashLife.Step(seeds, 1);
+    EXPECT_FALSE(seeds.Get({0, 0}));
+    EXPECT_TRUE(seeds.Get({-1, 0}));
+
+    hashLife.SetRule(*LifeRule::Make("B3/S23"));
+    HashQuadtree returned{block};
+    hashLife.Step(returned, 0);
+    VerifyContent(returned, block);
+}
+
+TEST(HashQuadtreeTest, InstancesKeepTheirOwnRules) {
+    // Pool threads step universes under different rules in turn, so each
+    // instance must apply its own rule rather than the thread's last one.
+    const LifeHashSet block{{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+    HashLife conwayLife{};
+    HashLife seedsLife{};
+    seedsLife.SetRule(*LifeRule::Make("B2/S"));
+
+    HashQuadtree conway{block};
+    conwayLife.Step(conway, 1);
+    VerifyContent(conway, block);
+
+    HashQuadtree seeds{block};
+    seedsLife.Clone()->Step(seeds, 1);
+    EXPECT_FALSE(seeds.Get({0, 0}));
+    EXPECT_TRUE(seeds.Get({-1, 0}));
+
+    conwayLife.Step(conway, 1);
+    VerifyContent(conway, block);
+}
+
+TEST(HashQuadtreeTest, SlowCacheStaysWithinBudget) {
+    // A budget of a handful of results forces evictions on every step without
+    // changing what the steps compute.
+    HashQuadtree::SetSlowCacheBudget(4 * RuleResultCache::SlowEntryBytes);
+
+    const LifeHashSet glider{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    HashQuadtree tree{glider};
+    for (auto i = 0; i < 8; ++i)
+        EXPECT_EQ(HashLife{}.Step(tree, 3), 3);
+
+    // Every four generations the glider moves one cell diagonally.
+    LifeHashSet expected{};
+    for (const auto cell : glider)
+        expected.insert(cell + Vec2{6, 6});
+    VerifyContent(tree, expected);
+    EXPECT_GT(HashQuadtree::SlowCacheStats().Evictions, 0U);
+
+    HashQuadtree::SetSlowCacheBudget(HashLifeCache::DefaultSlowCacheBudget);
+}
+
 // ========== Tests for Vec2L refactoring and bounds checking ==========
 
 TEST(HashQuadtreeTest, Vec2LInternalStoragePositiveCoordinates) {
@@ -749,4 +1022,142 @@ TEST(HashQuadtreeTest, Vec2LIteratorConstness) {
     EXPECT_TRUE(actual.contains({100, 200}));
     EXPECT_TRUE(actual.contains({-100, -200}));
 }
+
+TEST(HashQuadtreeTest, ReleasedCachesAreReused) {
+    const auto first = HashQuadtree::AcquireCache();
+    const auto second = HashQuadtree::AcquireCache();
+    EXPECT_NE(first, 0UZ);
+    EXPECT_NE(second, 0UZ);
+    EXPECT_NE(first, second);
+
+    HashQuadtree::SetCacheIndex(first);
+    const LifeHashSet cells{{0, 0}, {1, 0}, {2, 0}};
+    EXPECT_EQ(HashQuadtree{cells}.Population(), 3ULL);
+    HashQuadtree::SetCacheIndex(0);
+
+    HashQuadtree::ReleaseCache(first);
+    EXPECT_EQ(HashQuadtree::AcquireCache(), first);
+
+    HashQuadtree::ReleaseCache(first);
+    HashQuadtree::ReleaseCache(second);
+}
+
+TEST(HashQuadtreeTest, ReleasedCacheFreesNodesWithLastTree) {
+    const auto destroyed = LifeNodeArena::DestroyedCount();
+    // Wide enough that the tree is deeper than the one it is expanded to.
+    const LifeHashSet cells{{0, 0}, {1, 0}, {2, 0}, {100, 50}};
+
+    std::optional<HashQuadtree> tree{};
+    {
+        const HashLifeCacheLease lease{};
+        HashQuadtree::SetCacheIndex(lease.Index());
+        tree.emplace(cells);
+        HashQuadtree::SetCacheIndex(0);
+    }
+
+    // The tree outlives its cache, so its nodes must too.
+    EXPECT_EQ(LifeNodeArena::DestroyedCount(), destroyed);
+    EXPECT_EQ(tree->Population(), 4ULL);
+    EXPECT_TRUE(tree->Get({1, 0}));
+    EXPECT_TRUE(tree->Get({100, 50}));
+
+    tree.reset();
+    EXPECT_EQ(LifeNodeArena::DestroyedCount(), destroyed + 1);
+}
+
+TEST(HashQuadtreeTest, TreesMovedBetweenCachesLeaveNoArenaBehind) {
+    const auto destroyed = LifeNodeArena::DestroyedCount();
+    const LifeHashSet glider{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    const LifeHashSet blinker{{40, 0}, {41, 0}, {42, 0}};
+    {
+        const HashLifeCacheLease first{};
+        const HashLifeCacheLease second{};
+
+        HashQuadtree::SetCacheIndex(first.Index());
+        HashQuadtree a{glider};
+
+        // A into B, then the result back into A.
+        HashQuadtree::SetCacheIndex(second.Index());
+        HashQuadtree b{blinker};
+        b.Insert(a, {});
+        HashLife{}.Step(b, 2);
+
+        HashQuadtree::SetCacheIndex(first.Index());
+        a.Insert(b, {0, 20});
+        HashLife{}.Step(a, 2);
+        EXPECT_EQ(a.Population(), 13ULL);
+
+        HashQuadtree::SetCacheIndex(0);
+    }
+
+    EXPECT_EQ(LifeNodeArena::DestroyedCount(), destroyed + 2);
+}
+
+TEST(HashQuadtreeTest, SharedCacheCanonicalizesAcrossThreads) {
+    const auto first = HashQuadtree::AcquireSharedCache();
+    const auto second = HashQuadtree::AcquireSharedCache();
+    EXPECT_EQ(first, second);
+
+    const LifeHashSet cells{{0, 0}, {1, 0}, {2, 0}, {5, 7}, {-3, 4}};
+    std::array<const LifeNode*, 4> roots{};
+    {
+        std::vector<std::jthread> threads{};
+        for (auto i = 0UZ; i < roots.size(); ++i) {
+            threads.emplace_back([&, i] {
+                HashQuadtree::SetCacheIndex(first);
+                roots[i] = HashQuadtree{cells}.Data();
+            });
+        }
+    }
+
+    for (const auto* root : roots)
+        EXPECT_EQ(root, roots.front());
+
+    HashQuadtree::ReleaseCache(first);
+    HashQuadtree::ReleaseCache(second);
+}
+
+TEST(HashQuadtreeTest, SharedCacheStepsUniversesInParallel) {
+    const HashLifeCacheLease first{true};
+    const HashLifeCacheLease second{true};
+    ASSERT_EQ(first.Index(), second.Index());
+
+    const LifeHashSet glider{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    std::array<std::optional<HashQuadtree>, 4> trees{};
+    {
+        std::vector<std::jthread> threads{};
+        for (auto i = 0UZ; i < trees.size(); ++i) {
+            threads.emplace_back([&, i] {
+                HashQuadtree::SetCacheIndex(first.Index());
+                auto& tree = trees[i].emplace(glider);
+                // Half the threads take power-of-two steps, which use the
+                // fast results, and half take steps that use the slow ones.
+                if (i % 2 == 0) {
+                    for (auto step = 0; step < 6; ++step)
+                        HashLife{}.Step(tree, 4);
+                } else {
+                    for (auto step = 0; step < 8; ++step)
+                        HashLife{}.Step(tree, 3);
+                }
+            });
+        }
+    }
+
+    // Every four generations the glider moves one cell diagonally.
+    LifeHashSet expected{};
+    for (const auto cell : glider)
+        expected.insert(cell + Vec2{6, 6});
+    for (auto& tree : trees) {
+        VerifyContent(*tree, expected);
+        EXPECT_TRUE(*tree == *trees.front());
+    }
+
+    // Neither may pull the cache out from under its other user.
+    HashQuadtree::SetCacheIndex(first.Index());
+    const auto* root = HashQuadtree{glider}.Data();
+    EXPECT_FALSE(HashQuadtree::ClearCache());
+    EXPECT_FALSE(HashQuadtree::SetSlowCacheBudget(0));
+    EXPECT_EQ(HashQuadtree{glider}.Data(), root);
+    HashQuadtree::SetCacheIndex(0);
+}
 } // namespace gol
@@ -0,0 +1,119 @@
+#include <array>
+#include <gtest/gtest.h>
+
+#include "GameGrid.hpp"
+#include "HashQuadtree.hpp"
+#include "LargerThanLife.hpp"
+#include "LargerThanLifeRule.hpp"
+
+namespace gol {
+
+TEST(LargerThanLifeTest, ParsesBoscosRule) {
+    const auto rule = LargerThanLifeRule::Make("R5,C0,M1,S34..58,B34..45,NM");
+    ASSERT_TRUE(rule.has_value());
+
+    EXPECT_EQ(rule->Range(), 5);
+    EXPECT_TRUE(rule->CountsMiddle());
+    EXPECT_TRUE(rule->Survives(34));
+    EXPECT_TRUE(rule->Survives(58));
+    EXPECT_FALSE(rule->Survives(59));
+    EXPECT_TRUE(rule->IsBorn(45));
+    EXPECT_FALSE(rule->IsBorn(33));
+    EXPECT_FALSE(rule->Bounds().has_value());
+}
+
+TEST(LargerThanLifeTest, ParsesBoundedPlane) {
+    const auto rule = LargerThanLifeRule::Make("R2,C0,M0,S3..5,B4..6:P10,20");
+    ASSERT_TRUE(rule.has_value());
+    ASSERT_TRUE(rule->Bounds().has_value());
+    EXPECT_EQ(rule->Bounds()->Width, 10);
+    EXPECT_EQ(rule->Bounds()->Height, 20);
+}
+
+TEST(LargerThanLifeTest, InvalidRules) {
+    constexpr static std::array invalidRules{
+        "B3/S23"sv,
+        "R0,C0,M0,S1..2,B1..2"sv,
+        "R501,C0,M0,S1..2,B1..2"sv,
+        "R1,C1,M0,S1..2,B1..2"sv,
+        "R1,C-2,M0,S1..2,B1..2"sv,
+        "R1,C3,M0,S1..2,B1..2"sv,
+        "R1,C0,M2,S1..2,B1..2"sv,
+        "R1,C0,M0,S3..2,B1..2"sv,
+        "R1,C0,M0,S1..10,B1..2"sv,
+        "R1,C0,M0,S1..2,B0..2"sv,
+        "R1,C0,M0,S1..2,B1..2,NN"sv,
+        "R1,C0,M0,S1..2,B1..2:T5,5"sv,
+    };
+
+    for (const auto ruleString : invalidRules)
+        EXPECT_FALSE(LargerThanLifeRule::IsValidRule(ruleString).has_value())
+            << ruleString;
+}
+
+TEST(LargerThanLifeTest, GameGridDispatchesRuleNotation) {
+    EXPECT_TRUE(GameGrid::IsValidRule("B3/S23").has_value());
+    EXPECT_TRUE(
+        GameGrid::IsValidRule("R5,C0,M1,S34..58,B34..45,NM").has_value());
+
+    GameGrid grid{};
+    grid.SetRule("R5,C0,M1,S34..58,B34..45,NM");
+    EXPECT_EQ(grid.GetAlgorithm().GetIdentifier(), LargerThanLife::Identifier);
+
+    grid.SetRule("B3/S23");
+    EXPECT_EQ(grid.GetAlgorithm().GetIdentifier(), HashLife::Identifier);
+}
+
+TEST(LargerThanLifeTest, RangeOneMatchesConway) {
+    // With a range of 1 and the middle cell excluded, this is B3/S23.
+    LargerThanLife algorithm{
+        *LargerThanLifeRule::Make("R1,C0,M0,S2..3,B3..3")};
+
+    const LifeHashSet glider{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    HashQuadtree tree{glider};
+
+    EXPECT_EQ(algorithm.Step(tree, 4), 4);
+
+    // After four generations the glider has moved one cell diagonally.
+    EXPECT_EQ(tree.Population(), glider.size());
+    for (const auto cell : glider)
+        EXPECT_TRUE(tree.Get(cell + Vec2{1, 1}));
+}
+
+TEST(LargerThanLifeTest, DistantPatternsStepIndependently) {
+    LargerThanLife algorithm{
+        *LargerThanLifeRule::Make("R1,C2,M0,S2..3,B3..3")};
+
+    // The blinkers are far enough apart that a dense table spanning both
+    // could not be allocated.
+    constexpr Vec2 offset{1'000'000'000, -1'000'000'000};
+    LifeHashSet blinkers{};
+    for (const auto origin : {Vec2{}, offset})
+        for (auto x = 0; x < 3; ++x)
+            blinkers.insert(origin + Vec2{x, 0});
+    HashQuadtree tree{blinkers};
+
+    algorithm.Step(tree, 1);
+    EXPECT_EQ(tree.Population(), 6);
+    for (const auto origin : {Vec2{}, offset}) {
+        EXPECT_TRUE(tree.Get(origin + Vec2{1, -1}));
+        EXPECT_TRUE(tree.Get(origin + Vec2{1, 0}));
+        EXPECT_TRUE(tree.Get(origin + Vec2{1, 1}));
+    }
+}
+
+TEST(LargerThanLifeTest, BoundedPlaneDiscardsOutsideCells) {
+    LargerThanLife algorithm{
+        *LargerThanLifeRule::Make("R1,C0,M0,S2..3,B3..3:P3,3")};
+
+    // A blinker along the top edge loses the cell that would leave the plane.
+    const LifeHashSet blinker{{0, 0}, {1, 0}, {2, 0}};
+    HashQuadtree tree{blinker};
+
+    algorithm.Step(tree, 1);
+    EXPECT_FALSE(tree.Get({1, -1}));
+    EXPECT_TRUE(tree.Get({1, 0}));
+    EXPECT_TRUE(tree.Get({1, 1}));
+    EXPECT_EQ(tree.Population(), 2);
+}
+} // namespace gol
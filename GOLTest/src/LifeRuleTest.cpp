@@ -42,9 +42,9 @@ TEST(LifeRuleTest, TopologyAndBoundsExtraction) {
 }
 
 TEST(LifeRuleTest, InvalidRules) {
-    // B0 is explicitly rejected
-    const auto r1 = LifeRule::Make("B0/S23");
-    EXPECT_FALSE(r1.has_value());
+    // B0 can be combined with S8
+    const auto r1 = LifeRule::Make("B0/S238");
+    EXPECT_TRUE(r1.has_value());
 
     // Completely malformed
     const auto r2 = LifeRule::Make("not-a-rule");
@@ -64,8 +64,58 @@ TEST(LifeRuleTest, IsValidRuleChecks) {
 }
 
 TEST(LifeRuleTest, BirthZeroCheck) {
-    const auto rule = LifeRule::IsValidRule("B0/S23");
-    EXPECT_FALSE(rule.has_value());
+    EXPECT_TRUE(LifeRule::IsValidRule("B0/S23").has_value());
+    EXPECT_TRUE(LifeRule::IsValidRule("B03/S23:T16,16").has_value());
+    EXPECT_FALSE(LifeRule::IsValidRule("B0/S23:P16,16").has_value());
+    EXPECT_TRUE(LifeRule::IsValidRule("B0/S8").has_value());
+    EXPECT_TRUE(LifeRule::IsValidRule("B0/S238").has_value());
+}
+
+TEST(LifeRuleTest, BirthZeroPhaseTables) {
+    const auto rule = LifeRule::Make("B0/S23");
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_TRUE(rule->HasBirthOnZero());
+
+    // The raw table fills an empty neighborhood, but both phase tables keep
+    // the background empty.
+    EXPECT_EQ(rule->Table()[0], 0x33u);
+    EXPECT_EQ(rule->PhaseTable(0)[0], 0u);
+    EXPECT_EQ(rule->PhaseTable(1)[0], 0u);
+
+    // Rules without B0 use the same table for both phases.
+    const auto conway = LifeRule::Make("B3/S23");
+    ASSERT_TRUE(conway.has_value());
+    EXPECT_FALSE(conway->HasBirthOnZero());
+    EXPECT_EQ(conway->PhaseTable(1), conway->Table());
+}
+
+TEST(LifeRuleTest, BirthZeroSurviveEightComplemented) {
+    const auto rule = LifeRule::Make("B0/S8");
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_TRUE(rule->IsComplemented());
+
+    // One table serves every generation and keeps the background empty.
+    EXPECT_EQ(rule->PhaseTable(0), rule->PhaseTable(1));
+    EXPECT_EQ(rule->PhaseTable(0)[0], 0u);
+
+    // The complementary rule of B0/S8 is B12345678/S01234567.
+    EXPECT_EQ(rule->StoredBirthMask(), 0x1FE);
+    EXPECT_EQ(rule->StoredSurviveMask(), 0x0FF);
+
+    const auto plain = LifeRule::Make("B0/S23");
+    ASSERT_TRUE(plain.has_value());
+    EXPECT_FALSE(plain->IsComplemented());
+    EXPECT_EQ(plain->StoredBirthMask(), plain->BirthMask());
+}
+
+TEST(LifeRuleTest, FingerprintIgnoresBounds) {
+    const auto conway = LifeRule::Make("B3/S23");
+    const auto bounded = LifeRule::Make("B3/S23:T16,16");
+    const auto highLife = LifeRule::Make("B36/S23");
+    ASSERT_TRUE(conway && bounded && highLife);
+
+    EXPECT_EQ(conway->Fingerprint(), bounded->Fingerprint());
+    EXPECT_NE(conway->Fingerprint(), highLife->Fingerprint());
 }
 
 } // namespace gol
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <optional>
+
+#include "GameGrid.hpp"
+#include "PeriodDetector.hpp"
+
+namespace gol {
+namespace {
+GameGrid Pattern(std::initializer_list<Vec2> cells) {
+    GameGrid grid{};
+    for (const auto cell : cells)
+        grid.Set(cell.X, cell.Y, true);
+    return grid;
+}
+
+// Steps `grid` one generation at a time until the detector reports a cycle.
+std::optional<PeriodInfo> RunUntilCycle(GameGrid& grid, int32_t maxSteps) {
+    PeriodDetector detector{};
+    for (auto i = 0; i < maxSteps; ++i) {
+        if (const auto info = detector.Observe(grid))
+            return info;
+        grid.Update(1);
+    }
+    return std::nullopt;
+}
+} // namespace
+
+TEST(PeriodDetectorTest, FindsStillLifes) {
+    auto grid = Pattern({{0, 0}, {1, 0}, {0, 1}, {1, 1}});
+    const auto info = RunUntilCycle(grid, 4);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->Start, 0);
+    EXPECT_EQ(info->Period, 1);
+    EXPECT_EQ(info->Displacement, Vec2L{});
+}
+
+TEST(PeriodDetectorTest, FindsOscillators) {
+    auto grid = Pattern({{0, 0}, {0, 1}, {0, 2}});
+    const auto info = RunUntilCycle(grid, 8);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->Start, 0);
+    EXPECT_EQ(info->Period, 2);
+    EXPECT_EQ(info->Displacement, Vec2L{});
+}
+
+TEST(PeriodDetectorTest, FindsSpaceships) {
+    // Moves one cell down and to the right every four generations.
+    auto grid = Pattern({{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}});
+    const auto info = RunUntilCycle(grid, 256);
+    ASSERT_TRUE(info.has_value());
+    ASSERT_EQ(info->Period % 4, 0);
+
+    const auto cycles = static_cast<int64_t>(info->Period / 4);
+    EXPECT_EQ(info->Displacement, (Vec2L{cycles, cycles}));
+}
+} // namespace gol
@@ -0,0 +1,47 @@
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include "Profiler.hpp"
+
+namespace gol {
+
+TEST(ProfilerTest, CallTimesAreAveragedPerFrame) {
+    auto& profiler = Profiler::Get();
+    profiler.Sample();
+
+    using namespace std::chrono_literals;
+    profiler.AddTime(ProfileMetric::WorkerUpdate, 2ms);
+    profiler.AddTime(ProfileMetric::WorkerUpdate, 4ms);
+    profiler.Sample();
+    EXPECT_FLOAT_EQ(profiler.Latest(ProfileMetric::WorkerUpdate), 3.f);
+
+    // A frame without calls keeps showing the last average.
+    profiler.Sample();
+    EXPECT_FLOAT_EQ(profiler.Latest(ProfileMetric::WorkerUpdate), 3.f);
+}
+
+TEST(ProfilerTest, FrameTimesAreSummedPerFrame) {
+    auto& profiler = Profiler::Get();
+    profiler.Sample();
+
+    using namespace std::chrono_literals;
+    profiler.AddTime(ProfileMetric::Upload, 1ms);
+    profiler.AddTime(ProfileMetric::Upload, 2ms);
+    profiler.Sample();
+    EXPECT_FLOAT_EQ(profiler.Latest(ProfileMetric::Upload), 3.f);
+
+    profiler.Sample();
+    EXPECT_FLOAT_EQ(profiler.Latest(ProfileMetric::Upload), 0.f);
+}
+
+TEST(ProfilerTest, HistoryWrapsAround) {
+    auto& profiler = Profiler::Get();
+    const auto offset = profiler.HistoryOffset();
+    for (auto i = 0UZ; i < Profiler::HistoryLength; ++i)
+        profiler.Sample();
+
+    EXPECT_EQ(profiler.HistoryOffset(), offset);
+    EXPECT_EQ(profiler.History(ProfileMetric::FrameTime).size(),
+              Profiler::HistoryLength);
+}
+} // namespace gol
@@ -0,0 +1,46 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "SettingsChannel.hpp"
+
+namespace gol {
+
+TEST(SettingsChannelTest, ReadsSeeOnlyPublishedSettings) {
+    SettingsChannel<int32_t> channel;
+    EXPECT_EQ(channel.Read(), 0);
+
+    channel.Edit() = 1;
+    EXPECT_EQ(channel.Read(), 0);
+
+    channel.Publish();
+    EXPECT_EQ(channel.Read(), 1);
+    EXPECT_EQ(channel.Read(), 1);
+
+    // Only the latest of several publications is seen.
+    channel.Edit() = 2;
+    channel.Publish();
+    channel.Edit() = 3;
+    channel.Publish();
+    EXPECT_EQ(channel.Read(), 3);
+}
+
+TEST(SettingsChannelTest, ConcurrentReadsNeverGoBackwards) {
+    constexpr auto count = int64_t{100'000};
+    SettingsChannel<int64_t> channel;
+
+    std::jthread writer{[&] {
+        for (auto i = int64_t{1}; i <= count; ++i) {
+            channel.Edit() = i;
+            channel.Publish();
+        }
+    }};
+
+    auto last = int64_t{};
+    while (last < count) {
+        const auto value = channel.Read();
+        ASSERT_GE(value, last);
+        last = value;
+    }
+}
+} // namespace gol